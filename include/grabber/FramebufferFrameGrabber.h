@@ -1,5 +1,9 @@
 #pragma once
 
+// STL includes
+#include <cstddef>
+#include <cstdint>
+
 // Utils includes
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
@@ -8,7 +12,12 @@
 #include <utils/Logger.h>
 
 ///
-/// The FramebufferFrameGrabber is used for creating snapshots of the display (screenshots) 
+/// The FramebufferFrameGrabber is used for creating snapshots of the display (screenshots)
+///
+/// The framebuffer stays mapped between the snapshots; the screen information is checked once per
+/// second and the framebuffer is mapped again when it changed. Instead of a framebuffer device a
+/// regular file can be grabbed, e.g. a recorded framebuffer for benchmarks; its format is set with
+/// setFileFormat() (hyperion-framebuffer --file-format).
 ///
 class FramebufferFrameGrabber
 {
@@ -29,6 +38,26 @@ public:
 	///
 	void setVideoMode(const VideoMode videoMode);
 
+	///
+	/// Waits for the vertical sync of the display before every snapshot, if the driver supports it
+	/// @param[in] enable True to wait for the vertical sync
+	///
+	void setWaitForVsync(const bool enable);
+
+	///
+	/// Averages all pixels of the framebuffer instead of sampling every n-th pixel
+	/// @param[in] enable True to average the pixels
+	///
+	void setPixelAveraging(const bool enable);
+
+	///
+	/// Sets the format of a regular file grabbed instead of a framebuffer device
+	/// @param[in] xres The width of the file content [pixels]
+	/// @param[in] yres The height of the file content [pixels]
+	/// @param[in] bitsPerPixel The pixel depth (16, 24 or 32)
+	///
+	void setFileFormat(const unsigned xres, const unsigned yres, const unsigned bitsPerPixel);
+
 	///
 	/// Captures a single snapshot of the display and writes the data to the given image. The
 	/// provided image should have the same dimensions as the configured values (_width and
@@ -40,23 +69,62 @@ public:
 	void grabFrame(Image<ColorRgb> & image);
 
 private:
+	///
+	/// Opens and maps the framebuffer with its current screen information
+	/// @return true on success
+	///
+	bool openDevice();
+
+	/// Unmaps and closes the framebuffer
+	void closeDevice();
+
+	///
+	/// Reads the screen information of the framebuffer device
+	/// @return true on success
+	///
+	bool readScreenInfo(unsigned & xres, unsigned & yres, unsigned & bitsPerPixel, unsigned & lineLength);
+
 	/// Framebuffer file descriptor
 	int _fbfd;
 
 	/// Pointer to framebuffer
 	unsigned char * _fbp;
-	
+
+	/// The size of the mapped framebuffer [bytes]
+	size_t _mapSize;
+
 	/// Framebuffer device e.g. /dev/fb0
 	const std::string _fbDevice;
-	
+
+	/// true if the framebuffer is a regular file
+	bool _isFile;
+
+	/// The resolution, depth and line length of the mapped framebuffer
+	unsigned _xres;
+	unsigned _yres;
+	unsigned _bitsPerPixel;
+	unsigned _lineLength;
+
+	/// The pixel format of the mapped framebuffer
+	PixelFormat _pixelFormat;
+
+	/// The time of the next check of the screen information [ms]
+	int64_t _nextScreenInfoCheck;
+
+	/// true to wait for the vertical sync before every snapshot
+	bool _waitForVsync;
+
+	/// true if opening the framebuffer failed the last time, to report the error once
+	bool _openFailed;
+
 	/// With of the captured snapshot [pixels]
 	const unsigned _width;
-	
+
 	/// Height of the captured snapshot [pixels]
 	const unsigned _height;
 
 	/// Image resampler for downscaling the image
 	ImageResampler * _imgResampler;
-	
+
 	Logger * _log;
 };
@@ -47,6 +47,18 @@ public slots:
 	///
 	void setVideoMode(const VideoMode videoMode);
 
+	///
+	/// Waits for the vertical sync of the display before every grab, if the driver supports it
+	/// @param[in] enable True to wait for the vertical sync
+	///
+	void setWaitForVsync(const bool enable);
+
+	///
+	/// Averages all pixels of the framebuffer instead of sampling every n-th pixel
+	/// @param[in] enable True to average the pixels
+	///
+	void setPixelAveraging(const bool enable);
+
 private:
 	/// The update rate [Hz]
 	const int _updateInterval_ms;
@@ -16,13 +16,19 @@
 #include <utils/PixelFormat.h>
 #include <utils/VideoMode.h>
 #include <utils/ImageResampler.h>
+#include <utils/ImageStatistics.h>
 #include <utils/Logger.h>
 
 // grabber includes
 #include <grabber/VideoStandard.h>
 
+class MjpegDecoder;
+
 /// Capture class for V4L2 devices
 ///
+/// MJPEG frames are decoded downscaled in the DCT domain by the largest factor (1/2, 1/4 or 1/8)
+/// that does not exceed the pixel decimation, the remaining decimation is done by resampling.
+///
 /// @see http://linuxtv.org/downloads/v4l-dvb-apis/capture-example.html
 class V4L2Grabber : public QObject
 {
@@ -50,6 +56,14 @@ public slots:
 
 	void set3D(VideoMode mode);
 
+	void setPixelAveraging(bool enable);
+
+	///
+	/// Derives the pixel decimation from the capture resolution, so the images are at least of
+	/// the given size
+	///
+	void setTargetSize(int width, int height);
+
 	void setSignalThreshold(
 					double redSignalThreshold,
 					double greenSignalThreshold,
@@ -99,7 +113,22 @@ private:
 
 	bool process_image(const void *p, int size);
 
-	void process_image(const uint8_t *p);
+	void process_image(const uint8_t *p, int size);
+
+	/// Derives the pixel decimation from the target size if there is one
+	void updatePixelDecimation();
+
+	/// Sets the decimation and cropping of the resampler of the decoded MJPEG frames
+	void updateMjpegResampler();
+
+	///
+	/// Derives the offset of the chroma plane(s) of a planar format from the driver's frame size.
+	/// Drivers may pad the luma plane with extra rows (e.g. 1080 to 1088), the chroma follows the padding.
+	///
+	/// @param sizeImage The frame size reported by the driver
+	/// @return The byte offset of the chroma plane(s)
+	///
+	int planarChromaOffset(unsigned sizeImage) const;
 
 	int xioctl(int request, void *arg);
 
@@ -132,6 +161,8 @@ private:
 	int _width;
 	int _height;
 	int _lineLength;
+	/// Byte offset of the chroma plane(s) of planar formats (0 for all other formats)
+	int _chromaOffset;
 	int _frameByteSize;
 	int _frameDecimation;
 	int _noSignalCounterThreshold;
@@ -144,6 +175,28 @@ private:
 	QSocketNotifier * _streamNotifier;
 
 	ImageResampler _imageResampler;
+
+	/// The pixel decimation and cropping of the captured frames
+	int _horizontalPixelDecimation;
+	int _verticalPixelDecimation;
+	int _cropLeft;
+	int _cropRight;
+	int _cropTop;
+	int _cropBottom;
+
+	/// The minimum size of the images, 0 if the decimation is configured
+	int _targetWidth;
+	int _targetHeight;
+
+	/// The decoder of MJPEG frames and its downscaling
+	MjpegDecoder * _mjpegDecoder;
+	unsigned _mjpegScale;
+
+	/// The resampler of the decoded MJPEG frames
+	ImageResampler _mjpegResampler;
+
+	/// The signal detection area, for the no signal detection
+	ImageStatistics _imageStatistics;
 	
 	Logger * _log;
 	bool _initialized;
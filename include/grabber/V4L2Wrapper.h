@@ -34,6 +34,8 @@ public slots:
 	void setCropping(int cropLeft, int cropRight, int cropTop, int cropBottom);
 	void setSignalDetectionOffset(double verticalMin, double horizontalMin, double verticalMax, double horizontalMax);
 	void set3D(VideoMode mode);
+	void setPixelAveraging(bool enable);
+	void setTargetSize(int width, int height);
 
 // signals:
 // 	void emitColors(int priority, const std::vector<ColorRgb> &ledColors, const int timeout_ms);
@@ -43,7 +45,12 @@ private slots:
 	void readError(const char* err);
 
 	virtual void action();
-	void checkSources();
+
+protected:
+	///
+	/// Stops the streaming while a higher priority is visible, the buffers stay allocated
+	///
+	virtual void setSuspended(bool suspended);
 
 private:
 	/// The timeout of the led colors [ms]
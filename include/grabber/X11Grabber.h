@@ -24,6 +24,23 @@ public:
 	/// @param[in] mode The new video mode
 	///
 	void setVideoMode(const VideoMode videoMode);
+
+	///
+	/// Derives the pixel decimation from the screen size, so the images are at least of the given
+	/// size. The decimation is evaluated again when the screen resolution changes.
+	/// @param[in] width The minimum width of the images, 0 to keep the configured decimation
+	/// @param[in] height The minimum height of the images
+	///
+	void setTargetSize(const unsigned width, const unsigned height);
+
+	///
+	/// Enables tracking of the damaged screen regions with the XDamage extension. Frames without
+	/// damage of the captured area are not grabbed and the previous image is kept. Must be called
+	/// before Setup().
+	/// @param[in] enable True to track the damaged regions
+	/// @param[in] regionsOnly True to only update the damaged part of the image
+	///
+	void setDamageTracking(const bool enable, const bool regionsOnly);
 	
 	bool Setup();
 
@@ -35,7 +52,9 @@ public:
 	/// _height)
 	///
 	/// @param[out] image  The snapped screenshot (should be initialized with correct width and
-	/// height)
+	/// height). With damage tracking it must hold the previous frame.
+	///
+	/// @return -1 if the grab failed, 1 if the screen did not change and the image was kept, 0 otherwise
 	///
 	int grabFrame(Image<ColorRgb> & image);
 	
@@ -77,15 +96,38 @@ private:
 	int _horizontalDecimation;
 	int _verticalDecimation;
 
+	/// The minimum size of the images, 0 if the decimation is configured
+	unsigned _targetWidth;
+	unsigned _targetHeight;
+
 	unsigned _screenWidth;
 	unsigned _screenHeight;
 	unsigned _croppedWidth;
 	unsigned _croppedHeight;
 
 	Image<ColorRgb> _image;
+
+	VideoMode _videoMode;
+
+	/// XDamage tracking of the changed screen regions
+	bool _useXDamage, _XDamageAvailable, _damageRegionsOnly;
+	int _damageEventBase;
+	XID _damage;
+	XID _damageRegion;
+	/// True if the next frame must be grabbed completely
+	bool _damageFull;
+	/// The re-sampled damaged rows of the image
+	Image<ColorRgb> _damageImage;
 	
 	void freeResources();
 	void setupResources();
+
+	///
+	/// Fetches and resets the damage of the screen
+	/// @param[out] bounds The bounding box of the damaged screen region
+	/// @return false if the screen was not damaged since the last call
+	///
+	bool fetchDamage(XRectangle & bounds);
 	
 	
 	Logger * _log;
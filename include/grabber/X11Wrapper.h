@@ -34,6 +34,20 @@ public:
 	///
 	virtual ~X11Wrapper();
 
+	///
+	/// Derives the pixel decimation from the screen size, so the images are at least of the given size
+	/// @param[in] width The minimum width of the images
+	/// @param[in] height The minimum height of the images
+	///
+	void setTargetSize(const unsigned width, const unsigned height);
+
+	///
+	/// Skips the grab of frames without screen damage, see X11Grabber::setDamageTracking
+	/// @param[in] enable True to track the damaged regions
+	/// @param[in] regionsOnly True to only update the damaged part of the image
+	///
+	void setDamageTracking(const bool enable, const bool regionsOnly);
+
 public slots:
 	///
 	/// Starts the grabber wich produces led values with the specified update rate
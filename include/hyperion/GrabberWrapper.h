@@ -2,9 +2,11 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QMap>
 #include <string>
 #include <QString>
 #include <QStringList>
+#include <cstdint>
 
 #include <utils/Logger.h>
 #include <utils/Components.h>
@@ -33,6 +35,14 @@ public:
 
 	static QStringList availableGrabbers();
 
+	///
+	/// Suspends the grabber only while the given instance shows a higher priority as well. The main
+	/// instance is tracked from the start.
+	///
+	/// @param[in] hyperion The instance the images of the grabber are used for
+	///
+	void trackVisiblePriority(Hyperion * hyperion);
+
 public slots:
 	void componentStateChanged(const hyperion::Components component, bool enable);
 	
@@ -47,12 +57,40 @@ public slots:
 	///
 	void setGrabbingMode(const GrabbingMode mode);
 
+	///
+	/// Suspends the grabber while a higher priority is visible on all tracked instances
+	///
+	/// @param[in] priority The visible priority of the sending instance
+	///
+	void visiblePriorityChanged(int priority);
+
 signals:
 	void emitImage(int priority, const Image<ColorRgb> & image, const int timeout_ms);
 
 protected:
 
 	void setColors(const std::vector<ColorRgb> &ledColors, const int timeout_ms);
+
+	///
+	/// Called when the grabber is suspended or resumed. While suspended the timer only refreshes the
+	/// last led colors at a low rate, so the grabber stays selectable. Grabbers which are not driven
+	/// by the timer stop delivering frames here, but keep their resources for an instant resume.
+	///
+	/// @param[in] suspended True if the grabber is suspended
+	///
+	virtual void setSuspended(bool suspended);
+
+	///
+	/// Checks if a grabbed image has to be mapped to led colors again. An image with the same
+	/// signature as the previous one is only mapped again if the mapping settings changed or the
+	/// last mapping is older than a second (e.g. to follow the black border detection)
+	///
+	/// @param[in] signature The signature of the grabbed image (see Image::signature)
+	///
+	/// @return true if the image has to be mapped, false to reuse the previous led colors
+	///
+	bool imageChanged(const uint64_t signature);
+
 	QString _grabberName;
 	
 	/// Pointer to Hyperion for writing led values
@@ -74,4 +112,38 @@ protected:
 	ImageProcessor * _processor;
 
 	hyperion::Components _grabberComponentId;
+
+private slots:
+	///
+	/// Grabs a frame (action) or refreshes the led colors while the grabber is suspended
+	///
+	void timerAction();
+
+private:
+	///
+	/// Suspends or resumes the grabber according to the visible priorities
+	///
+	void updateSuspension();
+
+	/// The visible priority of every instance the images are used for
+	QMap<QObject*, int> _visiblePriorities;
+
+	/// True while a higher priority is visible
+	bool _suspended;
+
+	/// The timer interval while the grabber is not suspended
+	int _grabInterval;
+
+	/// The led colors set last, refreshed while the grabber is suspended
+	std::vector<ColorRgb> _lastLedColors;
+
+	/// The signature of the last mapped image
+	uint64_t _imageSignature;
+
+	/// The mapping settings of the last mapped image
+	int _imageMappingType;
+	bool _imageBlackBorderEnabled;
+
+	/// The time of the last mapping [ms], zero if there is none
+	int64_t _imageMappingTime;
 };
@@ -75,13 +75,37 @@ public:
 	static Hyperion* initInstance(const QJsonObject& qjsonConfig, const QString configFile);
 	static Hyperion* getInstance();
 
+	///
+	/// Creates an additional, named instance with its own leds, muxer, adjustments and device. It has no
+	/// effect engine and is not returned by getInstance(). The ownership is transferred to the caller.
+	///
+	/// @param[in] name The name of the instance
+	/// @param[in] qjsonConfig The Json configuration of the instance, must outlive the instance
+	/// @param[in] configFile The config file the configuration was read from
+	///
+	static Hyperion* createInstance(const QString & name, const QJsonObject& qjsonConfig, const QString configFile);
+
+	/// gets the name of the instance, empty for the main instance
+	const QString & getName() const { return _name; };
+
 	///
 	/// Returns the number of attached leds
 	///
 	unsigned getLedCount() const;
 
+	/// gets the led areas of this instance
+	const LedString & getLedString() const { return _ledString; };
+
 	QSize getLedGridSize() const { return _ledGridSize; };
 
+	/// gets the smallest image size at which every led area still covers enough pixels
+	/// @return the image size sufficient for the led layout
+	QSize getLedImageSize() const { return _ledImageSize; };
+
+	/// gets the hash of the led layout, used by clients that map images to leds on their own
+	/// @return the led layout hash
+	const QByteArray& getLedLayoutHash() const { return _ledLayoutHash; };
+
 	///
 	/// Returns the current priority
 	///
@@ -276,6 +300,21 @@ public:
 	static MessageForwarder * createMessageForwarder(const QJsonObject & forwarderConfig);
 	static QSize getLedLayoutGridSize(const QJsonValue& ledsConfig);
 
+	/**
+	 * Calculates the smallest image size at which each led area covers at least
+	 * LED_AREA_MIN_PIXELS pixels in both directions
+	 * @param ledString  The led string with the led areas
+	 * @return The image size sufficient for the led layout
+	 */
+	static QSize getLedLayoutImageSize(const LedString & ledString);
+
+	/// minimum number of pixels per direction an led area should cover
+	static const int LED_AREA_MIN_PIXELS = 4;
+
+	/// interval after which identical led values are written again [ms], as a keep-alive for
+	/// devices that time out without data (e.g. E1.31 receivers, Adalight watchdogs)
+	static const int LED_REWRITE_INTERVAL_MS = 1000;
+
 signals:
 	/// Signal which is emitted when a priority channel is actively cleared
 	/// This signal will not be emitted when a priority channel time out
@@ -285,6 +324,10 @@ signals:
 	/// This signal will not be emitted when a priority channel time out
 	void allChannelsCleared();
 
+	/// Signal which is emitted when another priority channel becomes visible, e.g. when an input
+	/// source with a higher priority is set, cleared or times out
+	void visiblePriorityChanged(int priority);
+
 	void componentStateChanged(const hyperion::Components component, bool enabled);
 
 	void imageToLedsMappingChanged(int mappingType);
@@ -304,8 +347,12 @@ private:
 	/// Constructs the Hyperion instance based on the given Json configuration
 	///
 	/// @param[in] qjsonConfig The Json configuration
+	/// @param[in] name The name of the instance, empty for the main instance
 	///
-	Hyperion(const QJsonObject& qjsonConfig, const QString configFile);
+	Hyperion(const QJsonObject& qjsonConfig, const QString configFile, const QString name = QString());
+
+	/// The name of the instance, empty for the main instance
+	const QString _name;
 
 	/// The specifiation of the led frame construction and picture integration
 	LedString _ledString;
@@ -344,6 +391,15 @@ private:
 	/// buffer for leds
 	std::vector<ColorRgb> _ledBuffer;
 
+	/// the led values of the last successful write, to skip writing identical values again
+	std::vector<ColorRgb> _lastLedBuffer;
+
+	/// true if the last led values were written through the smoothing
+	bool _lastWriteSmoothed;
+
+	/// the time of the last successful write [ms]
+	int64_t _lastWriteTime;
+
 	/// Logger instance
 	Logger * _log;
 
@@ -361,9 +417,18 @@ private:
 	/// holds the current priority channel that is manualy selected
 	int _currentSourcePriority;
 
+	/// the priority channel written to the leds last
+	int _visiblePriority;
+
 	QByteArray _configHash;
 
 	QSize _ledGridSize;
+
+	/// image size sufficient for the led layout
+	QSize _ledImageSize;
+
+	/// hash of the led layout (see LedString::layoutHash)
+	QByteArray _ledLayoutHash;
 	
 	int _ledMAppingType;
 	
@@ -0,0 +1,106 @@
+#pragma once
+
+// STL includes
+#include <list>
+#include <vector>
+
+// QT includes
+#include <QObject>
+#include <QString>
+#include <QJsonObject>
+#include <QMap>
+#include <QSize>
+#include <QThreadPool>
+
+// hyperion-utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+#include <utils/Logger.h>
+#include <utils/Components.h>
+
+// Forward class declaration
+class Hyperion;
+class ImageProcessor;
+
+///
+/// The additional named instances of the daemon ("instances" in the configuration). Every instance
+/// drives its own leds with its own priority muxer, color adjustments and led device, while the
+/// images of the grabbers are captured and converted once and shared with all instances.
+///
+/// An instance takes the "device", "leds", "color", "smoothing" and "blackborderdetector" sections
+/// of its configuration entry and the remaining sections from the main configuration. The network
+/// servers and the effects address the main instance only.
+///
+class HyperionInstances : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// Creates the instances of the configuration
+	///
+	/// @param[in] qjsonConfig The Json configuration of the daemon
+	/// @param[in] configFile The config file the configuration was read from
+	///
+	HyperionInstances(const QJsonObject & qjsonConfig, const QString & configFile);
+
+	///
+	/// Destructor; switches off and deletes the instances
+	///
+	~HyperionInstances();
+
+	/// @return The number of additional instances
+	unsigned count() const { return _instances.size(); };
+
+	///
+	/// Returns the smallest image size at which the led areas of all instances cover enough pixels
+	/// (see Hyperion::getLedImageSize)
+	///
+	/// @return The image size, 1x1 if there are no instances
+	///
+	QSize getLedImageSize() const;
+
+	///
+	/// Maps the images of the given grabber to the leds of all instances. The grabber keeps
+	/// grabbing while its priority is visible on any instance.
+	///
+	/// @param[in] grabber The grabber emitting the images (emitImage signal)
+	/// @param[in] component The component the led colors are set for
+	///
+	void addGrabber(QObject * grabber, const hyperion::Components component);
+
+public slots:
+	///
+	/// Maps the image to the leds of every instance, in parallel if there are several, and sets the
+	/// led colors of the instances with the given priority
+	///
+	/// @param[in] priority The priority of the grabber
+	/// @param[in] image The grabbed image
+	/// @param[in] timeout_ms The timeout of the led colors
+	///
+	void setImage(int priority, const Image<ColorRgb> & image, const int timeout_ms);
+
+private:
+	/// One additional instance and the processor mapping the shared images to its leds
+	struct Instance
+	{
+		Hyperion * hyperion;
+		ImageProcessor * processor;
+		std::vector<ColorRgb> ledColors;
+	};
+
+	/// The merged configurations of the instances, referenced by the instances
+	std::list<QJsonObject> _configs;
+
+	/// The instances
+	std::vector<Instance> _instances;
+
+	/// The component of every connected grabber
+	QMap<QObject*, hyperion::Components> _grabberComponents;
+
+	/// The threads mapping the images of all but the first instance
+	QThreadPool _mappingPool;
+
+	/// Logger instance
+	Logger * _log;
+};
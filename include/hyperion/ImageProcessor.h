@@ -9,6 +9,7 @@
 #include <hyperion/ImageProcessorFactory.h>
 #include <hyperion/LedString.h>
 #include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ImageToLedsMapCache.h>
 #include <utils/Logger.h>
 
 // Black border includes
@@ -145,12 +146,11 @@ private:
 	template <typename Pixel_T>
 	void verifyBorder(const Image<Pixel_T> & image)
 	{
-		if (!_borderProcessor->enabled() && ( _imageToLeds->horizontalBorder()!=0 || _imageToLeds->verticalBorder()!=0 ))
+		if (!_borderProcessor->enabled() && ( _wantedHorizontalBorder!=0 || _wantedVerticalBorder!=0 ))
 		{
 			Debug(Logger::getInstance("BLACKBORDER"), "disabled, reset border");
 			_borderProcessor->process(image);
-			delete _imageToLeds;
-			_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+			setBorder(0, 0);
 		}
 		
 		if(_borderProcessor->enabled() && _borderProcessor->process(image))
@@ -159,25 +159,35 @@ private:
 
 			const hyperion::BlackBorder border = _borderProcessor->getCurrentBorder();
 
-			// Clean up the old mapping
-			delete _imageToLeds;
-
 			if (border.unknown)
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+				setBorder(0, 0);
 			}
 			else
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), border.horizontalSize, border.verticalSize, _ledString.leds());
+				setBorder(border.horizontalSize, border.verticalSize);
 			}
 
 			Debug(Logger::getInstance("BLACKBORDER"),  "CURRENT BORDER TYPE: unknown=%d hor.size=%d vert.size=%d", 
 				border.unknown, border.horizontalSize, border.verticalSize );
 		}
+
+		// switch to the mapping of the border as soon as it is built
+		if (_imageToLeds->horizontalBorder() != _wantedHorizontalBorder || _imageToLeds->verticalBorder() != _wantedVerticalBorder)
+		{
+			updateMapping();
+		}
 	}
 
+	///
+	/// Sets the border of the mapping. The current mapping is used until the mapping for the border
+	/// is built in the background, unless it is cached already.
+	///
+	void setBorder(const unsigned horizontalBorder, const unsigned verticalBorder);
+
+	/// Switches to the mapping of the wanted border if it is built, requests it otherwise
+	void updateMapping();
+
 private:
 	Logger * _log;
 	/// The Led-string specification
@@ -186,8 +196,15 @@ private:
 	/// The processor for black border detection
 	hyperion::BlackBorderProcessor * _borderProcessor;
 
+	/// The mappings of the recently used image sizes and borders
+	hyperion::ImageToLedsMapCache _mapCache;
+
 	/// The mapping of image-pixels to leds
-	hyperion::ImageToLedsMap* _imageToLeds;
+	QSharedPointer<const hyperion::ImageToLedsMap> _imageToLeds;
+
+	/// The border of the mapping used as soon as it is built
+	unsigned _wantedHorizontalBorder;
+	unsigned _wantedVerticalBorder;
 
 	/// Type of image 2 led mapping
 	int _mappingType;
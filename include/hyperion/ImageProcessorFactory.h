@@ -41,6 +41,18 @@ public:
 	///
 	ImageProcessor* newImageProcessor() const;
 
+	///
+	/// Creates a new ImageProcessor for another led-configuration than the one of this factory. The
+	/// onwership of the processor is transferred to the caller.
+	///
+	/// @param[in] ledString  The led configuration
+	/// @param[in] blackborderConfig Contains the blackborder configuration
+	/// @param[in] mappingType The image to leds mapping type
+	///
+	/// @return The newly created ImageProcessor
+	///
+	ImageProcessor* newImageProcessor(const LedString& ledString, const QJsonObject &blackborderConfig, int mappingType) const;
+
 private:
 	/// The Led-string specification
 	LedString _ledString;
@@ -4,6 +4,7 @@
 // STL includes
 #include <cassert>
 #include <sstream>
+#include <functional>
 
 // hyperion-utils includes
 #include <utils/Image.h>
@@ -58,6 +59,9 @@ namespace hyperion
 
 		const unsigned horizontalBorder() const { return _horizontalBorder; };
 		const unsigned verticalBorder() const { return _verticalBorder; };
+
+		/// minimum number of mapped pixels to split the mapping across the threads of the mapping pool
+		static const unsigned PARALLEL_MIN_PIXELS = 65536;
 		
 		///
 		/// Determines the mean-color for each led using the mapping the image given
@@ -88,13 +92,17 @@ namespace hyperion
 			// Sanity check for the number of leds
 			assert(_colorsMap.size() == ledColors.size());
 
-			// Iterate each led and compute the mean
-			auto led = ledColors.begin();
-			for (auto ledColors = _colorsMap.begin(); ledColors != _colorsMap.end(); ++ledColors, ++led)
+			// small layouts are faster without the synchronisation of the threads
+			if (_chunkStarts.size() <= 1)
 			{
-				const ColorRgb color = calcMeanColor(image, *ledColors);
-				*led = color;
+				calcMeanColors(image, ledColors, 0, _colorsMap.size());
+				return;
 			}
+
+			runChunks([&](const unsigned ledStart, const unsigned ledEnd)
+			{
+				calcMeanColors(image, ledColors, ledStart, ledEnd);
+			});
 		}
 		
 		///
@@ -144,6 +152,29 @@ namespace hyperion
 		/// The absolute indices into the image for each led
 		std::vector<std::vector<unsigned>> _colorsMap;
 
+		/// The first led of every chunk of the parallel mapping, a single chunk maps sequentially
+		std::vector<unsigned> _chunkStarts;
+
+		///
+		/// Runs the work for every chunk of leds, on the calling thread and the threads of the mapping
+		/// pool. Returns when all chunks are done.
+		///
+		/// @param[in] work  The work for the leds [ledStart, ledEnd) of a chunk
+		///
+		void runChunks(const std::function<void(unsigned, unsigned)> & work) const;
+
+		///
+		/// Calculates the mean color of the leds [ledStart, ledEnd)
+		///
+		template <typename Pixel_T>
+		void calcMeanColors(const Image<Pixel_T> & image, std::vector<ColorRgb> & ledColors, const unsigned ledStart, const unsigned ledEnd) const
+		{
+			for (unsigned led = ledStart; led < ledEnd; ++led)
+			{
+				ledColors[led] = calcMeanColor(image, _colorsMap[led]);
+			}
+		}
+
 		///
 		/// Calculates the 'mean color' of the given list. This is the mean over each color-channel
 		/// (red, green, blue)
@@ -161,10 +192,10 @@ namespace hyperion
 				return ColorRgb::BLACK;
 			}
 
-			// Accumulate the sum of each seperate color channel
-			uint_fast16_t cummRed   = 0;
-			uint_fast16_t cummGreen = 0;
-			uint_fast16_t cummBlue  = 0;
+			// Accumulate the sum of each seperate color channel, 32 bit hold the sums of 2^24 pixels
+			uint32_t cummRed   = 0;
+			uint32_t cummGreen = 0;
+			uint32_t cummBlue  = 0;
 			for (const unsigned colorOffset : colors)
 			{
 				const Pixel_T& pixel = image.memptr()[colorOffset];
@@ -193,27 +224,26 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calcMeanColor(const Image<Pixel_T> & image) const
 		{
-			// Accumulate the sum of each seperate color channel
-			uint_fast16_t cummRed   = 0;
-			uint_fast16_t cummGreen = 0;
-			uint_fast16_t cummBlue  = 0;
-			const unsigned imageSize = image.width() * image.height();
+			// Accumulate the sum of each seperate color channel, 64 bit hold the sums of any image
+			uint64_t cummRed   = 0;
+			uint64_t cummGreen = 0;
+			uint64_t cummBlue  = 0;
+			const size_t imageSize = size_t(image.width()) * image.height();
+			if (imageSize == 0)
+			{
+				return ColorRgb::BLACK;
+			}
 
-			for (unsigned idx=0; idx<imageSize; idx++)
+			const Pixel_T * pixels = image.memptr();
+			for (size_t idx = 0; idx < imageSize; ++idx)
 			{
-				const Pixel_T& pixel = image.memptr()[idx];
-				cummRed   += pixel.red;
-				cummGreen += pixel.green;
-				cummBlue  += pixel.blue;
+				cummRed   += pixels[idx].red;
+				cummGreen += pixels[idx].green;
+				cummBlue  += pixels[idx].blue;
 			}
 
 			// Compute the average of each color channel
-			const uint8_t avgRed   = uint8_t(cummRed/imageSize);
-			const uint8_t avgGreen = uint8_t(cummGreen/imageSize);
-			const uint8_t avgBlue  = uint8_t(cummBlue/imageSize);
-
-			// Return the computed color
-			return {avgRed, avgGreen, avgBlue};
+			return {uint8_t(cummRed/imageSize), uint8_t(cummGreen/imageSize), uint8_t(cummBlue/imageSize)};
 		}
 	};
 
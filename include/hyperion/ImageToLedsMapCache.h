@@ -0,0 +1,61 @@
+#pragma once
+
+// STL includes
+#include <vector>
+
+// QT includes
+#include <QSharedPointer>
+
+// hyperion includes
+#include <hyperion/LedString.h>
+#include <hyperion/ImageToLedsMap.h>
+
+namespace hyperion
+{
+	class MapBuildTask;
+
+	///
+	/// The ImageToLedsMapCache keeps the mappings of the recently used image sizes and borders of a
+	/// led string, so a border switching back and forth does not rebuild the mapping every time.
+	/// Missing mappings can be built on a background thread while the caller keeps using its old one.
+	///
+	class ImageToLedsMapCache
+	{
+	public:
+		///
+		/// Constructs an empty cache for the given leds
+		///
+		/// @param[in] leds      The list with led specifications
+		/// @param[in] capacity  The number of mappings kept, the least recently used is dropped first
+		///
+		ImageToLedsMapCache(const std::vector<Led> & leds, const unsigned capacity = 8);
+
+		///
+		/// Returns the mapping if it is cached
+		///
+		/// @return The mapping or a null pointer if it is not (yet) built
+		///
+		QSharedPointer<const ImageToLedsMap> find(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder);
+
+		///
+		/// Returns the mapping, builds it on the calling thread if it is not cached
+		///
+		/// @return The mapping
+		///
+		QSharedPointer<const ImageToLedsMap> get(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder);
+
+		///
+		/// Builds the mapping on a background thread if it is neither cached nor already being built.
+		/// The mapping can be obtained with find() when it is ready.
+		///
+		void request(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder);
+
+	private:
+		friend class MapBuildTask;
+		struct Data;
+
+		/// The cached mappings, shared with the background builds which may outlive the cache
+		QSharedPointer<Data> _data;
+	};
+
+} // end namespace hyperion
@@ -11,6 +11,7 @@
 
 // QT includes
 #include <QString>
+#include <QByteArray>
 
 // Forward class declarations
 namespace Json { class Value; }
@@ -136,6 +137,14 @@ public:
 	///
 	const std::vector<Led>& leds() const;
 
+	///
+	/// Returns a hash over the integration areas of all leds. Two led strings with the same hash
+	/// map an image to exactly the same led colors.
+	///
+	/// @return The SHA1 hash of the led layout
+	///
+	QByteArray layoutHash() const;
+
 private:
 	/// The list with led specifications
 	std::vector<Led> mLeds;
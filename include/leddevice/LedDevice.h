@@ -56,9 +56,11 @@ public:
 	static const LedDeviceRegistry& getDeviceMap();
 	static void setActiveDevice(std::string dev);
 	static std::string activeDevice() { return _activeDevice; }
+	/// @return the schemas of all led devices, parsed on first use and cached
 	static QJsonObject getLedDeviceSchemas();
+	/// Sets the led count of the devices constructed from now on
 	static void setLedCount(int ledCount);
-	static int  getLedCount() { return _ledCount; }
+	int getLedCount() const { return _ledCount; }
 protected:
 	///
 	/// Writes the RGB-Color values to the leds.
@@ -81,9 +83,10 @@ protected:
 	static std::string _activeDevice;
 	static LedDeviceRegistry _ledDeviceMap;
 
-	static int _ledCount;
-	static int _ledRGBCount;
-	static int _ledRGBWCount;
+	/// The number of leds of this device and its buffer sizes in RGB and RGBW
+	int _ledCount;
+	int _ledRGBCount;
+	int _ledRGBWCount;
 
 	/// Timer object which makes sure that led data is written at a minimum rate
 	/// e.g. Adalight device will switch off when it does not receive data at least every 15 seconds
@@ -96,4 +99,7 @@ protected slots:
 
 private:
 	std::vector<ColorRgb> _ledValues;
+
+	/// The led count of the next constructed device
+	static int _nextLedCount;
 };
@@ -9,6 +9,9 @@
 #include <QTcpSocket>
 #include <QTimer>
 #include <QMap>
+#include <QJsonObject>
+#include <QSize>
+#include <QSharedMemory>
 
 // hyperion util
 #include <utils/Image.h>
@@ -17,8 +20,13 @@
 #include <utils/VideoMode.h>
 #include <utils/Logger.h>
 
+// hyperion includes
+#include <hyperion/LedString.h>
+
 #include <message.pb.h>
 
+class ImageProcessor;
+
 ///
 /// Connection class to setup an connection to the hyperion server and execute commands
 ///
@@ -43,6 +51,18 @@ public:
 	/// Do not read reply messages from Hyperion if set to true
 	void setSkipReply(bool skip);
 
+	/// Send images losslessly compressed if set to true (requires a server supporting image encodings)
+	void setImageCompression(bool compress);
+
+	///
+	/// Pass images through a shared memory ring instead of the socket. Only possible if the
+	/// server runs on the local host.
+	///
+	/// @param enable true to enable the shared memory transport
+	/// @return true if the shared memory transport is enabled
+	///
+	bool setSharedMemory(bool enable);
+
 	///
 	/// Set all leds to the specified color
 	///
@@ -53,7 +73,8 @@ public:
 	void setColor(const ColorRgb & color, int priority, int duration = 1);
 
 	///
-	/// Set the leds according to the given image (assume the image is stretched to the display size)
+	/// Set the leds according to the given image (assume the image is stretched to the display size).
+	/// Images are downscaled to the image size advertised by the server.
 	///
 	/// @param image The image
 	/// @param priority The priority
@@ -61,6 +82,25 @@ public:
 	///
 	void setImage(const Image<ColorRgb> & image, int priority, int duration = -1);
 
+	///
+	/// Set the leds to the given (already mapped) colors
+	///
+	/// @param ledColors The color per led
+	/// @param priority The priority
+	/// @param duration The duration in milliseconds
+	///
+	void setLedColors(const std::vector<ColorRgb> & ledColors, int priority, int duration = -1);
+
+	///
+	/// Enable the client side image to led mapping. Images passed to setImage() are translated to
+	/// led colors locally and only the led colors are sent to the server.
+	///
+	/// @param ledString The led layout of the hyperion server
+	/// @param blackborderConfig The blackborder detector configuration
+	/// @param mappingType The image to led mapping type
+	///
+	void setLedLayout(const LedString & ledString, const QJsonObject & blackborderConfig, int mappingType);
+
 	///
 	/// Clear the given priority channel
 	///
@@ -99,6 +139,23 @@ signals:
 
 private:
 
+	///
+	/// Copy the image into the next slot of the shared memory ring and tell the server about it
+	///
+	/// @param image The image
+	/// @param priority The priority
+	/// @param duration The duration in milliseconds
+	///
+	void setImageSharedMemory(const Image<ColorRgb> & image, int priority, int duration);
+
+	///
+	/// Switch to the socket after the server rejected a shared memory image (e.g. if it runs as
+	/// another user and can not attach the ring) and send the last image again
+	///
+	/// @param error The error reported by the server
+	///
+	void sharedMemoryRejected(const std::string & error);
+
 	///
 	/// Parse a reply message
 	///
@@ -121,6 +178,35 @@ private:
 	/// Skip receiving reply messages from Hyperion if set
 	bool _skipReply;
 
+	/// Compress images before sending if set
+	bool _imageCompression;
+
+	/// Image size advertised by the server (invalid if unknown)
+	QSize _imageSize;
+
+	/// Buffer for downscaled images
+	Image<ColorRgb> _scaledImage;
+
+	/// Pass images through shared memory if set
+	bool _useSharedMemory;
+
+	/// Shared memory ring for the images
+	QSharedMemory _sharedMemory;
+
+	/// Number of (re)creations of the shared memory ring, part of its key
+	unsigned _sharedMemoryGeneration;
+
+	/// Ring slot to use for the next image
+	int _sharedMemorySlot;
+
+	/// Size, priority and duration of the last image passed through the ring
+	QSize _sharedMemoryImageSize;
+	int _sharedMemoryPriority;
+	int _sharedMemoryDuration;
+
+	/// Number of image slots in the shared memory ring
+	static const int SHARED_MEMORY_SLOTS = 3;
+
 	QTimer _timer;
 	QAbstractSocket::SocketState  _prevSocketState;
 	
@@ -128,4 +214,13 @@ private:
 	QByteArray _receiveBuffer;
 	
 	Logger * _log;
+
+	/// The processor for client side led mapping (nullptr if images are sent to the server)
+	ImageProcessor * _imageProcessor;
+
+	/// Hash of the led layout used for client side led mapping
+	QByteArray _ledLayoutHash;
+
+	/// Buffer for the led colors of client side led mapping
+	std::vector<ColorRgb> _ledColors;
 };
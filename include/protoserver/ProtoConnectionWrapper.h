@@ -18,6 +18,28 @@ class ProtoConnectionWrapper : public QObject
 public:
 	ProtoConnectionWrapper(const QString &address, int priority, int duration_ms, bool skipProtoReply);
 	virtual ~ProtoConnectionWrapper();
+
+	///
+	/// Map the images to led colors locally with the led layout of the given hyperion configuration
+	/// and only send the led colors to the server
+	///
+	/// @param configFile The hyperion configuration file with the led layout of the server
+	///
+	void setLedLayout(const QString & configFile);
+
+	///
+	/// Send the images losslessly compressed
+	///
+	/// @param compress true to enable the compression
+	///
+	void setImageCompression(bool compress);
+
+	///
+	/// Pass the images through shared memory to a server on the local host
+	///
+	/// @param enable true to enable the shared memory transport
+	///
+	void setSharedMemory(bool enable);
 	
 signals:	
 	///
@@ -12,23 +12,46 @@
 #include <hyperion/Hyperion.h>
 #include <utils/Logger.h>
 #include <utils/Components.h>
+#include <utils/E131Packet.h>
 
 class UDPClientConnection;
 
 ///
-/// This class creates a UDP server which accepts connections from boblight clients.
+/// This class creates a UDP server which accepts led colors as raw rgb byte stream or as
+/// E1.31 (sACN) / Art-Net DMX universes.
 ///
 class UDPListener : public QObject
 {
 	Q_OBJECT
 
 public:
+	///
+	/// Supported udp protocols
+	///
+	enum Protocol
+	{
+		/// one datagram contains the rgb bytes of all leds
+		RAW,
+		/// E1.31 (sACN) data packets, one universe per datagram
+		E131,
+		/// Art-Net ArtDmx packets, one universe per datagram
+		ARTNET
+	};
+
 	///
 	/// UDPListener constructor
-	/// @param hyperion Hyperion instance
-	/// @param port port number on which to start listening for connections
+	/// @param priority hyperion priority channel
+	/// @param timeout timeout of the led colors
+	/// @param address address to bind (a multicast address joins the group)
+	/// @param listenPort port number on which to start listening for connections
+	/// @param shared share the port with other applications
+	/// @param protocol the udp protocol ("raw", "e131" or "artnet")
+	/// @param universe the first universe holding led data (E1.31/Art-Net)
+	/// @param syncUniverse universe of the synchronization packets, 0 to show frames once all universes arrived (E1.31/Art-Net)
+	/// @param channelsPerUniverse number of dmx channels used per universe (E1.31/Art-Net)
 	///
-	UDPListener(const int priority, const int timeout, const QString& address, quint16 listenPort, bool shared);
+	UDPListener(const int priority, const int timeout, const QString& address, quint16 listenPort, bool shared,
+		const QString& protocol = "raw", const int universe = 1, const int syncUniverse = 0, const int channelsPerUniverse = DMX_MAX);
 	~UDPListener();
 
 	///
@@ -60,10 +83,51 @@ signals:
 
 private slots:
 	///
-	/// Slot which is called when a client tries to create a new connection
+	/// Slot which is called when datagrams are pending. All pending datagrams are drained, only
+	/// the newest one is processed.
 	///
 	void readPendingDatagrams();
-	void processTheDatagram(const QByteArray * _datagram);
+
+	///
+	/// Decodes the raw rgb bytes of the datagram into the led buffer and passes it to hyperion
+	///
+	/// @param datagram The datagram buffer
+	/// @param size The size of the datagram in the buffer
+	///
+	void processTheDatagram(const QByteArray & datagram, const qint64 size);
+
+private:
+	///
+	/// Parses an E1.31 data or synchronization packet
+	///
+	/// @param data The datagram
+	/// @param size The size of the datagram
+	///
+	void processE131Datagram(const uint8_t * data, const qint64 size);
+
+	///
+	/// Parses an Art-Net ArtDmx or ArtSync packet
+	///
+	/// @param data The datagram
+	/// @param size The size of the datagram
+	///
+	void processArtNetDatagram(const uint8_t * data, const qint64 size);
+
+	///
+	/// Copies the dmx data of an universe into the led buffer
+	///
+	/// @param universe The universe of the dmx data
+	/// @param sequence The sequence number of the packet (0 = no sequence)
+	/// @param data The dmx channel values
+	/// @param count The number of dmx channel values
+	/// @param synchronized true if the sender sends synchronization packets for this universe
+	///
+	void processUniverse(const int universe, const uint8_t sequence, const uint8_t * data, int count, const bool synchronized);
+
+	///
+	/// Passes the assembled led buffer to hyperion and starts a new frame
+	///
+	void commitFrame();
 
 private:
 	/// Hyperion instance
@@ -91,4 +155,34 @@ private:
 	QHostAddress _listenAddress;
 	quint16      _listenPort;
 	QAbstractSocket::BindFlag _bondage;
+
+	/// receive buffer, reused for all datagrams
+	QByteArray _datagram;
+
+	/// led buffer, reused for all datagrams
+	std::vector<ColorRgb> _ledColors;
+
+	/// udp protocol
+	Protocol _protocol;
+
+	/// first universe with led data
+	int _universe;
+
+	/// universe of the synchronization packets (0 = none)
+	int _syncUniverse;
+
+	/// dmx channels used per universe
+	int _channelsPerUniverse;
+
+	/// number of universes of one frame
+	int _universeCount;
+
+	/// universes received for the current frame
+	std::vector<bool> _universeReceived;
+
+	/// number of universes missing for the current frame
+	int _universesPending;
+
+	/// last sequence number per universe (-1 = none received)
+	std::vector<int> _universeSequence;
 };
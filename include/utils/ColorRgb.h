@@ -74,3 +74,14 @@ inline bool operator>=(const ColorRgb & lhs, const ColorRgb & rhs)
 	return (lhs.red >= rhs.red) && (lhs.green >= rhs.green) && (lhs.blue >= rhs.blue);
 }
 
+/// Compare operator to check if a color is 'equal' to another color
+inline bool operator==(const ColorRgb & lhs, const ColorRgb & rhs)
+{
+	return (lhs.red == rhs.red) && (lhs.green == rhs.green) && (lhs.blue == rhs.blue);
+}
+
+/// Compare operator to check if a color is not 'equal' to another color
+inline bool operator!=(const ColorRgb & lhs, const ColorRgb & rhs)
+{
+	return !(lhs == rhs);
+}
@@ -2,12 +2,120 @@
 
 // STL includes
 #include <vector>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include <utils/ColorRgb.h>
 
+///
+/// A non-owning view of a rectangle of pixels, e.g. a part of an Image. Consecutive rows are
+/// 'stride' pixels apart. The view is only valid as long as the pixels it refers to.
+///
+template <typename Pixel_T>
+class ImageView
+{
+public:
+
+	typedef Pixel_T pixel_type;
+
+	///
+	/// Constructor for a view of the given pixels
+	///
+	/// @param pixels The first pixel of the view
+	/// @param width The width of the view
+	/// @param height The height of the view
+	/// @param stride The distance of two rows [pixels]
+	///
+	ImageView(const Pixel_T * pixels, const unsigned width, const unsigned height, const unsigned stride) :
+		_pixels(pixels),
+		_width(width),
+		_height(height),
+		_stride(stride)
+	{
+	}
+
+	inline unsigned width() const
+	{
+		return _width;
+	}
+
+	inline unsigned height() const
+	{
+		return _height;
+	}
+
+	///
+	/// Returns the distance of two rows
+	///
+	/// @return The distance of two rows [pixels]
+	///
+	inline unsigned stride() const
+	{
+		return _stride;
+	}
+
+	///
+	/// Returns the first pixel of a row
+	///
+	/// @param y The row index
+	///
+	/// @return pointer to the first pixel of the row
+	///
+	inline const Pixel_T* row(const unsigned y) const
+	{
+		return _pixels + size_t(y)*_stride;
+	}
+
+	///
+	/// Returns a const reference to a specified pixel in the view
+	///
+	/// @param x The x index
+	/// @param y The y index
+	///
+	/// @return const reference to specified pixel
+	///
+	inline const Pixel_T& operator()(const unsigned x, const unsigned y) const
+	{
+		return row(y)[x];
+	}
 
+	///
+	/// Returns a view of a part of this view, without copying pixels
+	///
+	/// @param x The left column of the part
+	/// @param y The top row of the part
+	/// @param width The width of the part
+	/// @param height The height of the part
+	///
+	/// @return The view of the part
+	///
+	ImageView<Pixel_T> view(const unsigned x, const unsigned y, const unsigned width, const unsigned height) const
+	{
+		assert(x + width <= _width);
+		assert(y + height <= _height);
+
+		return ImageView<Pixel_T>(row(y) + x, width, height, _stride);
+	}
+
+private:
+	/// The first pixel of the view
+	const Pixel_T * _pixels;
+	/// The width of the view
+	unsigned _width;
+	/// The height of the view
+	unsigned _height;
+	/// The distance of two rows [pixels]
+	unsigned _stride;
+};
+
+///
+/// An image with its pixels stored row after row. Copies of an image share the pixels until one of
+/// them is modified (copy-on-write), so images can be passed by value, e.g. through queued Qt
+/// signals, without copying the pixels. The pixels are aligned to a cache line.
+///
 template <typename Pixel_T>
 class Image
 {
@@ -15,16 +123,17 @@ public:
 
 	typedef Pixel_T pixel_type;
 
+	/// Alignment of the pixels [bytes]
+	static const size_t ALIGNMENT = 64;
+
 	///
-	/// Default constructor for an image
+	/// Default constructor for an image, a single black pixel that allocates on the first write
 	///
 	Image() :
 		_width(1),
 		_height(1),
-		_pixels(new Pixel_T[2]),
-		_endOfPixels(_pixels + 1)
+		_data(nullptr)
 	{
-		memset(_pixels, 0, 2*sizeof(Pixel_T));
 	}
 
 	///
@@ -36,10 +145,9 @@ public:
 	Image(const unsigned width, const unsigned height) :
 		_width(width),
 		_height(height),
-		_pixels(new Pixel_T[width * height + 1]),
-		_endOfPixels(_pixels + width * height)
+		_data(allocate(size_t(width) * height))
 	{
-		memset(_pixels, 0, (_width*_height+1)*sizeof(Pixel_T));
+		memset(_data->pixels, 0, (size_t(_width)*_height+1)*sizeof(Pixel_T));
 	}
 
 	///
@@ -52,22 +160,91 @@ public:
 	Image(const unsigned width, const unsigned height, const Pixel_T background) :
 		_width(width),
 		_height(height),
-		_pixels(new Pixel_T[width * height + 1]),
-		_endOfPixels(_pixels + width * height)
+		_data(allocate(size_t(width) * height))
+	{
+		std::fill(_data->pixels, _data->pixels + size_t(_width)*_height + 1, background);
+	}
+
+	///
+	/// Constructor for an image with a copy of the pixels of the given view
+	///
+	/// @param view The pixels of the image
+	///
+	explicit Image(const ImageView<Pixel_T> & view) :
+		_width(view.width()),
+		_height(view.height()),
+		_data(allocate(size_t(view.width()) * view.height()))
 	{
-		std::fill(_pixels, _endOfPixels, background);
+		for (unsigned y = 0; y < _height; ++y)
+		{
+			memcpy(_data->pixels + size_t(y)*_width, view.row(y), _width * sizeof(Pixel_T));
+		}
+		memset(_data->pixels + size_t(_width)*_height, 0, sizeof(Pixel_T));
 	}
 
 	///
-	/// Copy constructor for an image
+	/// Copy constructor for an image, shares the pixels until one of the images is modified
 	///
 	Image(const Image & other) :
 		_width(other._width),
 		_height(other._height),
-		_pixels(new Pixel_T[other._width * other._height + 1]),
-		_endOfPixels(_pixels + other._width * other._height)
+		_data(other._data)
+	{
+		if (_data != nullptr)
+		{
+			++_data->refs;
+		}
+	}
+
+	///
+	/// Move constructor for an image, the other image becomes the default image
+	///
+	Image(Image && other) :
+		_width(other._width),
+		_height(other._height),
+		_data(other._data)
+	{
+		other._width  = 1;
+		other._height = 1;
+		other._data   = nullptr;
+	}
+
+	///
+	/// Assignment of an image, shares the pixels until one of the images is modified
+	///
+	Image & operator=(const Image & other)
 	{
-		memcpy(_pixels, other._pixels, other._width * other._height * sizeof(Pixel_T));
+		if (_data != other._data)
+		{
+			release();
+			_data = other._data;
+			if (_data != nullptr)
+			{
+				++_data->refs;
+			}
+		}
+		_width  = other._width;
+		_height = other._height;
+		return *this;
+	}
+
+	///
+	/// Move assignment of an image, the other image becomes the default image
+	///
+	Image & operator=(Image && other)
+	{
+		if (this != &other)
+		{
+			release();
+			_width  = other._width;
+			_height = other._height;
+			_data   = other._data;
+
+			other._width  = 1;
+			other._height = 1;
+			other._data   = nullptr;
+		}
+		return *this;
 	}
 
 	///
@@ -75,7 +252,7 @@ public:
 	///
 	~Image()
 	{
-		delete[] _pixels;
+		release();
 	}
 
 	///
@@ -98,19 +275,29 @@ public:
 		return _height;
 	}
 
+	///
+	/// Returns the distance of two rows, the rows of an image are stored without gaps
+	///
+	/// @return The distance of two rows [pixels]
+	///
+	inline unsigned stride() const
+	{
+		return _width;
+	}
+
 	uint8_t red(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->red;
+		return (memptr() + pixel)->red;
 	}
 
 	uint8_t green(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->green;
+		return (memptr() + pixel)->green;
 	}
 
 	uint8_t blue(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->blue;
+		return (memptr() + pixel)->blue;
 	}
 
 	///
@@ -123,11 +310,12 @@ public:
 	///
 	const Pixel_T& operator()(const unsigned x, const unsigned y) const
 	{
-		return _pixels[toIndex(x,y)];
+		return memptr()[toIndex(x,y)];
 	}
 
 	///
-	/// Returns a reference to a specified pixel in the image
+	/// Returns a reference to a specified pixel in the image. Detaches shared pixels on every call,
+	/// loops over many pixels should use memptr() once instead.
 	///
 	/// @param x The x index
 	/// @param y The y index
@@ -136,7 +324,33 @@ public:
 	///
 	Pixel_T& operator()(const unsigned x, const unsigned y)
 	{
-		return _pixels[toIndex(x,y)];
+		return memptr()[toIndex(x,y)];
+	}
+
+	///
+	/// Returns a view of the whole image
+	///
+	/// @return The view, valid until the image is modified or destroyed
+	///
+	ImageView<Pixel_T> view() const
+	{
+		return ImageView<Pixel_T>(memptr(), _width, _height, stride());
+	}
+
+	///
+	/// Returns a view of a part of the image (e.g. a cropped area or a half of a 3D frame)
+	/// without copying pixels
+	///
+	/// @param x The left column of the part
+	/// @param y The top row of the part
+	/// @param width The width of the part
+	/// @param height The height of the part
+	///
+	/// @return The view, valid until the image is modified or destroyed
+	///
+	ImageView<Pixel_T> view(const unsigned x, const unsigned y, const unsigned width, const unsigned height) const
+	{
+		return view().view(x, y, width, height);
 	}
 
 	/// Resize the image
@@ -144,11 +358,16 @@ public:
 	/// @param height The height of the image
 	void resize(const unsigned width, const unsigned height)
 	{
-		if ((width*height) > unsigned((_endOfPixels-_pixels)))
+		const size_t pixelCount = size_t(width) * height;
+		if (_data == nullptr || pixelCount > _data->capacity)
+		{
+			release();
+			_data = allocate(pixelCount);
+			memset(_data->pixels + pixelCount, 0, sizeof(Pixel_T));
+		}
+		else
 		{
-			delete[] _pixels;
-			_pixels = new Pixel_T[width*height + 1];
-			_endOfPixels = _pixels + width*height;
+			detach();
 		}
 
 		_width = width;
@@ -165,16 +384,18 @@ public:
 		assert(other._width == _width);
 		assert(other._height == _height);
 
-		memcpy(_pixels, other._pixels, _width*_height*sizeof(Pixel_T));
+		memcpy(memptr(), other.memptr(), size_t(_width)*_height*sizeof(Pixel_T));
 	}
 
 	///
-	/// Returns a memory pointer to the first pixel in the image
+	/// Returns a memory pointer to the first pixel in the image. The pixels are copied first if
+	/// they are shared with another image.
 	/// @return The memory pointer to the first pixel
 	///
 	Pixel_T* memptr()
 	{
-		return _pixels;
+		detach();
+		return _data->pixels;
 	}
 
 	///
@@ -183,28 +404,123 @@ public:
 	///
 	const Pixel_T* memptr() const
 	{
-		return _pixels;
+		return (_data != nullptr) ? _data->pixels : blackPixels();
 	}
 
+	///
+	/// Returns a hash of the size and of evenly spread samples of the pixels, to detect unchanged
+	/// images cheaply. Images with at most maxSamples pixels are hashed completely.
+	///
+	/// @param maxSamples The maximum number of sampled pixels
+	///
+	/// @return The signature of the image
+	///
+	uint64_t signature(const unsigned maxSamples = 4096) const
+	{
+		// 64 bit FNV-1a
+		uint64_t hash = 14695981039346656037ULL;
+		const uint64_t prime = 1099511628211ULL;
+
+		hash = (hash ^ _width) * prime;
+		hash = (hash ^ _height) * prime;
+
+		const size_t pixelCount = size_t(_width) * _height;
+		const size_t step = (pixelCount > maxSamples) ? pixelCount / maxSamples + 1 : 1;
+		const Pixel_T * pixels = memptr();
+		for (size_t idx = 0; idx < pixelCount; idx += step)
+		{
+			const uint8_t * bytes = reinterpret_cast<const uint8_t *>(pixels + idx);
+			for (size_t i = 0; i < sizeof(Pixel_T); ++i)
+			{
+				hash = (hash ^ bytes[i]) * prime;
+			}
+		}
+		return hash;
+	}
 
 	///
 	/// Convert image of any color order to a RGB image.
 	///
 	/// @param[out] image  The image that buffers the output
 	///
-	void toRgb(Image<ColorRgb>& image)
+	void toRgb(Image<ColorRgb>& image) const
 	{
 		image.resize(_width, _height);
 		const unsigned imageSize = _width * _height;
+		const Pixel_T * pixels = memptr();
+		ColorRgb * rgbPixels = image.memptr();
 
 		for (unsigned idx=0; idx<imageSize; idx++)
 		{
-			const Pixel_T color = memptr()[idx];
-			image.memptr()[idx] = ColorRgb{color.red, color.green, color.blue};
+			const Pixel_T color = pixels[idx];
+			rgbPixels[idx] = ColorRgb{color.red, color.green, color.blue};
 		}
 	}
 
 private:
+	///
+	/// The pixel storage shared by copies of an image
+	///
+	struct ImageData
+	{
+		/// The number of images sharing the pixels
+		std::atomic<unsigned> refs;
+		/// The number of pixels that fit, without the extra pixel
+		size_t capacity;
+		/// The allocated memory
+		uint8_t * allocation;
+		/// The aligned pixels within the allocated memory
+		Pixel_T * pixels;
+	};
+
+	///
+	/// Allocates the aligned storage for the given number of pixels plus an extra pixel
+	///
+	static ImageData* allocate(const size_t pixelCount)
+	{
+		ImageData * data = new ImageData();
+		data->refs       = 1;
+		data->capacity   = pixelCount;
+		data->allocation = new uint8_t[(pixelCount + 1) * sizeof(Pixel_T) + ALIGNMENT - 1];
+		data->pixels     = reinterpret_cast<Pixel_T*>((uintptr_t(data->allocation) + ALIGNMENT - 1) & ~uintptr_t(ALIGNMENT - 1));
+		return data;
+	}
+
+	/// Drops this image's share of the pixels
+	void release()
+	{
+		if (_data != nullptr && --_data->refs == 0)
+		{
+			delete[] _data->allocation;
+			delete _data;
+		}
+		_data = nullptr;
+	}
+
+	/// Makes sure the pixels are owned by this image only, before they are modified
+	void detach()
+	{
+		if (_data == nullptr)
+		{
+			const size_t pixelCount = size_t(_width) * _height;
+			_data = allocate(pixelCount);
+			memset(_data->pixels, 0, (pixelCount+1)*sizeof(Pixel_T));
+		}
+		else if (_data->refs.load(std::memory_order_acquire) > 1)
+		{
+			ImageData * data = allocate(_data->capacity);
+			memcpy(data->pixels, _data->pixels, (_data->capacity+1)*sizeof(Pixel_T));
+			release();
+			_data = data;
+		}
+	}
+
+	/// The pixels of the default image, which has no storage of its own
+	static const Pixel_T* blackPixels()
+	{
+		static const Pixel_T pixels[2] = {};
+		return pixels;
+	}
 
 	///
 	/// Translate x and y coordinate to index of the underlying vector
@@ -225,9 +541,6 @@ private:
 	/// The height of the image
 	unsigned _height;
 
-	/// The pixels of the image
-	Pixel_T* _pixels;
-
-	/// Pointer to the last(extra) pixel
-	Pixel_T* _endOfPixels;
+	/// The pixels of the image, nullptr for the default image
+	ImageData* _data;
 };
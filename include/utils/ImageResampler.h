@@ -22,12 +22,38 @@ public:
 
 	void set3D(VideoMode mode);
 
-	void processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> & outputImage) const;
+	///
+	/// Enables averaging of all source pixels of an output pixel (box filter) instead of sampling a
+	/// single source pixel. Averaging reads every source pixel, but gives stable colors at a high
+	/// decimation.
+	///
+	/// @param enable True to average the source pixels
+	///
+	void setAveraging(bool enable);
+
+	///
+	/// Converts the source image to a cropped and decimated RGB image
+	///
+	/// @param chromaOffset Byte offset of the chroma plane(s) of the planar formats NV12 and I420,
+	/// 0 if the chroma directly follows the (unpadded) luma plane at lineLength*height
+	///
+	void processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> & outputImage, int chromaOffset = 0) const;
 
 private:
 	static inline uint8_t clamp(int x);
 	static void yuv2rgb(uint8_t y, uint8_t u, uint8_t v, uint8_t & r, uint8_t & g, uint8_t & b);
 
+	///
+	/// Converts the pixels [xStart, xStart+count) of a source row to RGB
+	///
+	static void convertRow(const uint8_t * data, int chromaOffset, int lineLength, PixelFormat pixelFormat, int y, int xStart, int count, ColorRgb * row);
+
+	///
+	/// Decimates the cropped source image by averaging the source pixels of every output pixel
+	///
+	void averageImage(const uint8_t * data, int width, int height, int lineLength, int chromaOffset, PixelFormat pixelFormat,
+					  int cropLeft, int cropRight, int cropTop, int cropBottom, Image<ColorRgb> & outputImage) const;
+
 private:
 	int _horizontalDecimation;
 	int _verticalDecimation;
@@ -36,4 +62,5 @@ private:
 	int _cropTop;
 	int _cropBottom;
 	VideoMode _videoMode;
+	bool _averaging;
 };
@@ -0,0 +1,88 @@
+#pragma once
+
+// STL includes
+#include <algorithm>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// Statistics of the center region of an image, e.g. for the no signal detection of the grabbers
+///
+class ImageStatistics
+{
+public:
+	///
+	/// Constructs the statistics with the whole image as center region
+	///
+	ImageStatistics() :
+		_xFracMin(0.0),
+		_yFracMin(0.0),
+		_xFracMax(1.0),
+		_yFracMax(1.0)
+	{
+	}
+
+	///
+	/// Sets the center region of the image, as fractions of the width and height of the image
+	///
+	/// @param xFracMin The left side of the region [0.0 .. 1.0]
+	/// @param yFracMin The top side of the region [0.0 .. 1.0]
+	/// @param xFracMax The right side of the region [0.0 .. 1.0]
+	/// @param yFracMax The bottom side of the region [0.0 .. 1.0]
+	///
+	void setCenterRegion(const double xFracMin, const double yFracMin, const double xFracMax, const double yFracMax)
+	{
+		_xFracMin = xFracMin;
+		_yFracMin = yFracMin;
+		_xFracMax = xFracMax;
+		_yFracMax = yFracMax;
+	}
+
+	///
+	/// Checks if a pixel of the center region exceeds the threshold in any channel. Stops at the
+	/// first such pixel, so images with a signal are rarely scanned completely.
+	///
+	/// @param image The image
+	/// @param threshold The threshold color
+	/// @return true if a pixel is not below or equal to the threshold
+	///
+	template <typename Pixel_T>
+	bool centerExceeds(const Image<Pixel_T> & image, const ColorRgb & threshold) const
+	{
+		unsigned xMin, yMin, xMax, yMax;
+		centerRegion(image.width(), image.height(), xMin, yMin, xMax, yMax);
+
+		for (unsigned y = yMin; y < yMax; ++y)
+		{
+			const Pixel_T * row = image.memptr() + size_t(y) * image.stride();
+			for (unsigned x = xMin; x < xMax; ++x)
+			{
+				if (row[x].red > threshold.red || row[x].green > threshold.green || row[x].blue > threshold.blue)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+private:
+	///
+	/// Returns the center region of an image of the given size, empty if it is smaller than a pixel
+	///
+	void centerRegion(const unsigned width, const unsigned height, unsigned & xMin, unsigned & yMin, unsigned & xMax, unsigned & yMax) const
+	{
+		xMin = std::min(width,  unsigned(width  * _xFracMin));
+		yMin = std::min(height, unsigned(height * _yFracMin));
+		xMax = std::max(xMin, std::min(width,  unsigned(width  * _xFracMax)));
+		yMax = std::max(yMin, std::min(height, unsigned(height * _yFracMax)));
+	}
+
+	/// The center region [fractions of the image size]
+	double _xFracMin;
+	double _yFracMin;
+	double _xFracMax;
+	double _yFracMax;
+};
@@ -9,10 +9,14 @@
 enum PixelFormat {
 	PIXELFORMAT_YUYV,
 	PIXELFORMAT_UYVY,
+	PIXELFORMAT_NV12,
+	PIXELFORMAT_I420,
 	PIXELFORMAT_BGR16,
 	PIXELFORMAT_BGR24,
+	PIXELFORMAT_RGB24,
 	PIXELFORMAT_RGB32,
 	PIXELFORMAT_BGR32,
+	PIXELFORMAT_MJPEG,
 	PIXELFORMAT_NO_CHANGE
 };
 
@@ -29,6 +33,14 @@ inline PixelFormat parsePixelFormat(std::string pixelFormat)
 	{
 		return PIXELFORMAT_UYVY;
 	}
+	else if (pixelFormat == "nv12")
+	{
+		return PIXELFORMAT_NV12;
+	}
+	else if (pixelFormat == "i420" || pixelFormat == "yu12")
+	{
+		return PIXELFORMAT_I420;
+	}
 	else if (pixelFormat == "bgr16")
 	{
 		return PIXELFORMAT_BGR16;
@@ -37,6 +49,10 @@ inline PixelFormat parsePixelFormat(std::string pixelFormat)
 	{
 		return PIXELFORMAT_BGR24;
 	}
+	else if (pixelFormat == "rgb24")
+	{
+		return PIXELFORMAT_RGB24;
+	}
 	else if (pixelFormat == "rgb32")
 	{
 		return PIXELFORMAT_RGB32;
@@ -45,6 +61,10 @@ inline PixelFormat parsePixelFormat(std::string pixelFormat)
 	{
 		return PIXELFORMAT_BGR32;
 	}
+	else if (pixelFormat == "mjpeg")
+	{
+		return PIXELFORMAT_MJPEG;
+	}
 
 	// return the default NO_CHANGE
 	return PIXELFORMAT_NO_CHANGE;
@@ -3,11 +3,15 @@
 #include <utils/ColorRgb.h>
 #include <utils/ColorRgbw.h>
 
+// STL includes
+#include <vector>
+
 namespace RGBW {
 
 	enum WhiteAlgorithm { INVALID, SUBTRACT_MINIMUM, SUB_MIN_WARM_ADJUST, WHITE_OFF };
 	
 	WhiteAlgorithm stringToWhiteAlgorithm(std::string str);
 	void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, const WhiteAlgorithm algorithm);
+	void Rgb_to_Rgbw(const std::vector<ColorRgb> & input, std::vector<ColorRgbw> & output, const WhiteAlgorithm algorithm);
 
 };
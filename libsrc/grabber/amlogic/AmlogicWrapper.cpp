@@ -43,7 +43,11 @@ void AmlogicWrapper::action()
 	_image.toRgb(image_rgb);
 	emit emitImage(_priority, image_rgb, _timeout_ms);
 
-	_processor->process(_image, _ledColors);
+	// map the image only if it changed, the previous colors are set again otherwise
+	if (imageChanged(_image.signature()))
+	{
+		_processor->process(_image, _ledColors);
+	}
 	setColors(_ledColors, _timeout_ms);
 }
 
@@ -7,47 +7,53 @@
 #include <sys/ioctl.h>
 
 // STL includes
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 
+// Qt includes
+#include <QDateTime>
+
 // Local includes
 #include <grabber/FramebufferFrameGrabber.h>
 
+namespace
+{
+	/// interval of the screen information checks [ms]
+	const int64_t SCREENINFO_CHECK_INTERVAL_MS = 1000;
+}
+
 FramebufferFrameGrabber::FramebufferFrameGrabber(const std::string & device, const unsigned width, const unsigned height) :
-	_fbfd(0),
-	_fbp(0),
+	_fbfd(-1),
+	_fbp(nullptr),
+	_mapSize(0),
 	_fbDevice(device),
+	_isFile(false),
+	_xres(0),
+	_yres(0),
+	_bitsPerPixel(0),
+	_lineLength(0),
+	_pixelFormat(PIXELFORMAT_NO_CHANGE),
+	_nextScreenInfoCheck(0),
+	_waitForVsync(false),
+	_openFailed(false),
 	_width(width),
 	_height(height),
 	_imgResampler(new ImageResampler()),
 	_log(Logger::getInstance("FRAMEBUFFERGRABBER"))
 {
-	int result;
-	struct fb_var_screeninfo vinfo;
-
-	// Check if the framebuffer device can be opened and display the current resolution
-	_fbfd = open(_fbDevice.c_str(), O_RDONLY);
-	if (_fbfd == 0)
-	{
-		Error(_log, "Error openning %s", _fbDevice.c_str());
-	}
-	else 
+	// Check if the framebuffer device can be opened and display the current resolution. The format
+	// of a regular file is set after the construction, a file is opened with the first grab.
+	struct stat fileStat;
+	if (stat(_fbDevice.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
 	{
-		// get variable screen information
-		result = ioctl (_fbfd, FBIOGET_VSCREENINFO, &vinfo);
-		if (result != 0)
-		{
-			Error(_log, "Could not get screen information");
-		}
-		else
-		{
-			Error(_log, "Display opened with resolution: %dx%d@%dbit", vinfo.xres, vinfo.yres, vinfo.bits_per_pixel);			
-		}
-		close(_fbfd);
+		openDevice();
 	}
 }
 
 FramebufferFrameGrabber::~FramebufferFrameGrabber()
 {
+	closeDevice();
 	delete _imgResampler;
 }
 
@@ -56,52 +62,178 @@ void FramebufferFrameGrabber::setVideoMode(const VideoMode videoMode)
 	_imgResampler->set3D(videoMode);
 }
 
-void FramebufferFrameGrabber::grabFrame(Image<ColorRgb> & image)
+void FramebufferFrameGrabber::setWaitForVsync(const bool enable)
+{
+	_waitForVsync = enable;
+}
+
+void FramebufferFrameGrabber::setPixelAveraging(const bool enable)
+{
+	_imgResampler->setAveraging(enable);
+}
+
+void FramebufferFrameGrabber::setFileFormat(const unsigned xres, const unsigned yres, const unsigned bitsPerPixel)
+{
+	_xres         = xres;
+	_yres         = yres;
+	_bitsPerPixel = bitsPerPixel;
+	_lineLength   = xres * (bitsPerPixel / 8);
+
+	// map the file again with the new format
+	if (_isFile)
+	{
+		closeDevice();
+	}
+}
+
+bool FramebufferFrameGrabber::readScreenInfo(unsigned & xres, unsigned & yres, unsigned & bitsPerPixel, unsigned & lineLength)
 {
 	struct fb_var_screeninfo vinfo;
-	unsigned capSize, bytesPerPixel;
-	PixelFormat pixelFormat;
+	if (ioctl(_fbfd, FBIOGET_VSCREENINFO, &vinfo) != 0)
+	{
+		return false;
+	}
+
+	xres         = vinfo.xres;
+	yres         = vinfo.yres;
+	bitsPerPixel = vinfo.bits_per_pixel;
 
-	/* Open the framebuffer device */
+	// the lines may be padded, use the line length of the driver if it tells it
+	struct fb_fix_screeninfo finfo;
+	lineLength = (ioctl(_fbfd, FBIOGET_FSCREENINFO, &finfo) == 0 && finfo.line_length > 0)
+		? finfo.line_length
+		: vinfo.xres * (vinfo.bits_per_pixel / 8);
+
+	return true;
+}
+
+bool FramebufferFrameGrabber::openDevice()
+{
 	_fbfd = open(_fbDevice.c_str(), O_RDONLY);
+	if (_fbfd < 0)
+	{
+		ErrorIf(!_openFailed, _log, "Error openning %s: %s", _fbDevice.c_str(), strerror(errno));
+		_openFailed = true;
+		return false;
+	}
 
-	/* get variable screen information */
-	ioctl (_fbfd, FBIOGET_VSCREENINFO, &vinfo);
+	struct stat fileStat;
+	_isFile = (fstat(_fbfd, &fileStat) == 0) && S_ISREG(fileStat.st_mode);
 
-	bytesPerPixel = vinfo.bits_per_pixel / 8;
-	capSize = vinfo.xres * vinfo.yres * bytesPerPixel;
-	
-	if (vinfo.bits_per_pixel == 16)
+	// a file is mapped as soon as its format is set
+	if (_isFile && _bitsPerPixel == 0)
 	{
-		pixelFormat = PIXELFORMAT_BGR16;
+		ErrorIf(!_openFailed, _log, "%s is a regular file, its format has to be set (hyperion-framebuffer --file-format)", _fbDevice.c_str());
+		_openFailed = true;
+		closeDevice();
+		return false;
 	}
-	else if (vinfo.bits_per_pixel == 24)
+
+	if (!_isFile && !readScreenInfo(_xres, _yres, _bitsPerPixel, _lineLength))
+	{
+		ErrorIf(!_openFailed, _log, "Could not get screen information");
+		_openFailed = true;
+		closeDevice();
+		return false;
+	}
+
+	switch (_bitsPerPixel)
+	{
+		case 16: _pixelFormat = PIXELFORMAT_BGR16; break;
+		case 24: _pixelFormat = PIXELFORMAT_BGR24; break;
+		case 32: _pixelFormat = PIXELFORMAT_BGR32; break;
+		default:
+			ErrorIf(!_openFailed, _log, "Unknown pixel format: %d bits per pixel", _bitsPerPixel);
+			_openFailed = true;
+			closeDevice();
+			return false;
+	}
+
+	_mapSize = size_t(_lineLength) * _yres;
+	if (_isFile && size_t(fileStat.st_size) < _mapSize)
+	{
+		ErrorIf(!_openFailed, _log, "%s holds %ld bytes, the format %dx%d@%dbit needs %zu bytes",
+			_fbDevice.c_str(), long(fileStat.st_size), _xres, _yres, _bitsPerPixel, _mapSize);
+		_openFailed = true;
+		closeDevice();
+		return false;
+	}
+
+	/* map the device to memory */
+	void * fbp = mmap(0, _mapSize, PROT_READ, _isFile ? MAP_SHARED : (MAP_PRIVATE | MAP_NORESERVE), _fbfd, 0);
+	if (fbp == MAP_FAILED)
 	{
-		pixelFormat = PIXELFORMAT_BGR24;
-	}	
-	else if (vinfo.bits_per_pixel == 32)
+		ErrorIf(!_openFailed, _log, "Could not map %s: %s", _fbDevice.c_str(), strerror(errno));
+		_openFailed = true;
+		closeDevice();
+		return false;
+	}
+	_fbp = static_cast<unsigned char*>(fbp);
+
+	Info(_log, "Display opened with resolution: %dx%d@%dbit", _xres, _yres, _bitsPerPixel);
+	_openFailed          = false;
+	_nextScreenInfoCheck = QDateTime::currentMSecsSinceEpoch() + SCREENINFO_CHECK_INTERVAL_MS;
+
+	_imgResampler->setHorizontalPixelDecimation(_xres/_width);
+	_imgResampler->setVerticalPixelDecimation(_yres/_height);
+
+	return true;
+}
+
+void FramebufferFrameGrabber::closeDevice()
+{
+	if (_fbp != nullptr)
 	{
-		pixelFormat = PIXELFORMAT_BGR32;
+		munmap(_fbp, _mapSize);
+		_fbp = nullptr;
 	}
-	else
+	if (_fbfd >= 0)
 	{
-		Error(_log, "Unknown pixel format: %d bits per pixel", vinfo.bits_per_pixel);
 		close(_fbfd);
+		_fbfd = -1;
+	}
+}
+
+void FramebufferFrameGrabber::grabFrame(Image<ColorRgb> & image)
+{
+	if (_fbp == nullptr && !openDevice())
+	{
 		return;
 	}
-			
-	/* map the device to memory */
-	_fbp = (unsigned char*)mmap(0, capSize, PROT_READ, MAP_PRIVATE | MAP_NORESERVE, _fbfd, 0);	
 
-	_imgResampler->setHorizontalPixelDecimation(vinfo.xres/_width);
-	_imgResampler->setVerticalPixelDecimation(vinfo.yres/_height);
+	// the mode of the display may change, map the framebuffer again when it did
+	const int64_t now = QDateTime::currentMSecsSinceEpoch();
+	if (!_isFile && now >= _nextScreenInfoCheck)
+	{
+		_nextScreenInfoCheck = now + SCREENINFO_CHECK_INTERVAL_MS;
+
+		unsigned xres, yres, bitsPerPixel, lineLength;
+		if (!readScreenInfo(xres, yres, bitsPerPixel, lineLength)
+			|| xres != _xres || yres != _yres || bitsPerPixel != _bitsPerPixel || lineLength != _lineLength)
+		{
+			Info(_log, "Screen information changed");
+			closeDevice();
+			if (!openDevice())
+			{
+				return;
+			}
+		}
+	}
+
+	if (_waitForVsync && !_isFile)
+	{
+		__u32 screen = 0;
+		if (ioctl(_fbfd, FBIO_WAITFORVSYNC, &screen) != 0)
+		{
+			Warning(_log, "The framebuffer does not support waiting for the vertical sync, disabled");
+			_waitForVsync = false;
+		}
+	}
+
 	_imgResampler->processImage(_fbp,
-								vinfo.xres,
-								vinfo.yres,
-								vinfo.xres * bytesPerPixel,
-								pixelFormat,
+								_xres,
+								_yres,
+								_lineLength,
+								_pixelFormat,
 								image);
-	
-	munmap(_fbp, capSize);
-	close(_fbfd);
 }
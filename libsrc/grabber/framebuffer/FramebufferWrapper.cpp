@@ -33,7 +33,11 @@ void FramebufferWrapper::action()
 
 	emit emitImage(_priority, _image, _timeout_ms);
 	
-	_processor->process(_image, _ledColors);
+	// map the image only if it changed, the previous colors are set again otherwise
+	if (imageChanged(_image.signature()))
+	{
+		_processor->process(_image, _ledColors);
+	}
 	setColors(_ledColors, _timeout_ms);
 }
 
@@ -41,3 +45,13 @@ void FramebufferWrapper::setVideoMode(const VideoMode mode)
 {
 	_grabber->setVideoMode(mode);
 }
+
+void FramebufferWrapper::setWaitForVsync(const bool enable)
+{
+	_grabber->setWaitForVsync(enable);
+}
+
+void FramebufferWrapper::setPixelAveraging(const bool enable)
+{
+	_grabber->setPixelAveraging(enable);
+}
@@ -33,7 +33,11 @@ void OsxWrapper::action()
 
 	emit emitImage(_priority, _image, _timeout_ms);
 
-	_processor->process(_image, _ledColors);
+	// map the image only if it changed, the previous colors are set again otherwise
+	if (imageChanged(_image.signature()))
+	{
+		_processor->process(_image, _ledColors);
+	}
 	setColors(_ledColors, _timeout_ms);
 }
 
@@ -0,0 +1,144 @@
+// STL includes
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+
+// Local includes
+#include "MjpegDecoder.h"
+
+#ifdef ENABLE_MJPEG
+#include <jpeglib.h>
+
+namespace
+{
+	/// The error manager of libjpeg, jumps back to the decoder instead of exiting
+	struct ErrorManager
+	{
+		struct jpeg_error_mgr base;
+		jmp_buf jump;
+		char message[JMSG_LENGTH_MAX];
+	};
+
+	void errorExit(j_common_ptr cinfo)
+	{
+		ErrorManager * errorManager = reinterpret_cast<ErrorManager *>(cinfo->err);
+		(*cinfo->err->format_message)(cinfo, errorManager->message);
+		longjmp(errorManager->jump, 1);
+	}
+
+	void outputMessage(j_common_ptr)
+	{
+		// warnings of corrupt frames are expected from capture devices, a failed frame is reported by decode()
+	}
+}
+
+struct MjpegDecoder::Decompressor
+{
+	struct jpeg_decompress_struct cinfo;
+	ErrorManager errorManager;
+};
+
+MjpegDecoder::MjpegDecoder()
+	: _decompressor(new Decompressor())
+	, _pixels()
+	, _width(0)
+	, _height(0)
+	, _error()
+{
+	_decompressor->cinfo.err = jpeg_std_error(&_decompressor->errorManager.base);
+	_decompressor->errorManager.base.error_exit     = errorExit;
+	_decompressor->errorManager.base.output_message = outputMessage;
+	jpeg_create_decompress(&_decompressor->cinfo);
+}
+
+MjpegDecoder::~MjpegDecoder()
+{
+	jpeg_destroy_decompress(&_decompressor->cinfo);
+	delete _decompressor;
+}
+
+bool MjpegDecoder::available()
+{
+	return true;
+}
+
+bool MjpegDecoder::decode(const uint8_t * data, const size_t size, const unsigned scale)
+{
+	struct jpeg_decompress_struct & cinfo = _decompressor->cinfo;
+
+	if (setjmp(_decompressor->errorManager.jump))
+	{
+		_error = _decompressor->errorManager.message;
+		jpeg_abort_decompress(&cinfo);
+		return false;
+	}
+
+	// frames without huffman tables (common for MJPEG) get the standard tables of libjpeg(-turbo)
+	jpeg_mem_src(&cinfo, const_cast<unsigned char *>(data), size);
+	jpeg_read_header(&cinfo, TRUE);
+
+	cinfo.out_color_space     = JCS_RGB;
+	cinfo.scale_num           = 1;
+	cinfo.scale_denom         = scale;
+	cinfo.dct_method          = JDCT_IFAST;
+	cinfo.do_fancy_upsampling = FALSE;
+	cinfo.do_block_smoothing  = FALSE;
+
+	jpeg_start_decompress(&cinfo);
+
+	_width  = cinfo.output_width;
+	_height = cinfo.output_height;
+	const size_t lineLength = size_t(_width) * 3;
+	_pixels.resize(lineLength * _height);
+
+	while (cinfo.output_scanline < cinfo.output_height)
+	{
+		JSAMPROW row = _pixels.data() + lineLength * cinfo.output_scanline;
+		jpeg_read_scanlines(&cinfo, &row, 1);
+	}
+
+	jpeg_finish_decompress(&cinfo);
+	return true;
+}
+
+#else
+
+struct MjpegDecoder::Decompressor
+{
+};
+
+MjpegDecoder::MjpegDecoder()
+	: _decompressor(nullptr)
+	, _pixels()
+	, _width(0)
+	, _height(0)
+	, _error()
+{
+}
+
+MjpegDecoder::~MjpegDecoder()
+{
+}
+
+bool MjpegDecoder::available()
+{
+	return false;
+}
+
+bool MjpegDecoder::decode(const uint8_t *, const size_t, const unsigned)
+{
+	_error = "hyperion is built without MJPEG support (libjpeg)";
+	return false;
+}
+
+#endif
+
+unsigned MjpegDecoder::scaleForDecimation(const int decimation)
+{
+	unsigned scale = 1;
+	while (scale < 8 && int(scale * 2) <= decimation)
+	{
+		scale *= 2;
+	}
+	return scale;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+// STL includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///
+/// Decoder for the MJPEG frames of V4L2 devices. The frames are decoded downscaled by 1/2, 1/4 or
+/// 1/8 in the DCT domain, which is much faster than decoding the full frame and decimating it.
+/// The decoder is only functional if hyperion is built with libjpeg, see available().
+///
+class MjpegDecoder
+{
+public:
+	MjpegDecoder();
+	~MjpegDecoder();
+
+	///
+	/// Returns true if MJPEG frames can be decoded, i.e. hyperion is built with libjpeg
+	///
+	static bool available();
+
+	///
+	/// Returns the largest downscaling of the decoder (1, 2, 4 or 8) not larger than the given
+	/// decimation
+	///
+	/// @param decimation The wanted decimation of the image
+	///
+	/// @return The downscaling
+	///
+	static unsigned scaleForDecimation(const int decimation);
+
+	///
+	/// Decodes a frame to RGB24 pixels
+	///
+	/// @param data The JPEG frame
+	/// @param size The size of the frame [bytes]
+	/// @param scale The downscaling (1, 2, 4 or 8)
+	///
+	/// @return true if the frame could be decoded
+	///
+	bool decode(const uint8_t * data, const size_t size, const unsigned scale);
+
+	/// The decoded RGB24 pixels, row after row without padding
+	inline const uint8_t * pixels() const
+	{
+		return _pixels.data();
+	}
+
+	/// The width of the decoded image [pixels]
+	inline int width() const
+	{
+		return _width;
+	}
+
+	/// The height of the decoded image [pixels]
+	inline int height() const
+	{
+		return _height;
+	}
+
+	/// The reason of the last failed decoding
+	inline const std::string & error() const
+	{
+		return _error;
+	}
+
+private:
+	/// The decompressor of libjpeg, kept between the frames
+	struct Decompressor;
+	Decompressor * _decompressor;
+
+	/// The decoded pixels
+	std::vector<uint8_t> _pixels;
+	int _width;
+	int _height;
+
+	std::string _error;
+};
@@ -20,6 +20,7 @@
 #include <QFileInfo>
 
 #include "grabber/V4L2Grabber.h"
+#include "MjpegDecoder.h"
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
 
@@ -43,6 +44,7 @@ V4L2Grabber::V4L2Grabber(const std::string & device
 	, _width(width)
 	, _height(height)
 	, _lineLength(-1)
+	, _chromaOffset(0)
 	, _frameByteSize(-1)
 	, _frameDecimation(std::max(1, frameDecimation))
 	, _noSignalCounterThreshold(50)
@@ -51,6 +53,18 @@ V4L2Grabber::V4L2Grabber(const std::string & device
 	, _noSignalCounter(0)
 	, _streamNotifier(nullptr)
 	, _imageResampler()
+	, _horizontalPixelDecimation(std::max(1, horizontalPixelDecimation))
+	, _verticalPixelDecimation(std::max(1, verticalPixelDecimation))
+	, _cropLeft(0)
+	, _cropRight(0)
+	, _cropTop(0)
+	, _cropBottom(0)
+	, _targetWidth(0)
+	, _targetHeight(0)
+	, _mjpegDecoder(new MjpegDecoder())
+	, _mjpegScale(1)
+	, _mjpegResampler()
+	, _imageStatistics()
 	, _log(Logger::getInstance("V4L2:"+QString::fromStdString(device)))
 	, _initialized(false)
 	, _deviceAutoDiscoverEnabled(false)
@@ -61,8 +75,10 @@ V4L2Grabber::V4L2Grabber(const std::string & device
 	, _y_frac_max(0.75)
 
 {
-	_imageResampler.setHorizontalPixelDecimation(std::max(1, horizontalPixelDecimation));
-	_imageResampler.setVerticalPixelDecimation(std::max(1, verticalPixelDecimation));
+	_imageResampler.setHorizontalPixelDecimation(_horizontalPixelDecimation);
+	_imageResampler.setVerticalPixelDecimation(_verticalPixelDecimation);
+	updateMjpegResampler();
+	_imageStatistics.setCenterRegion(_x_frac_min, _y_frac_min, _x_frac_max, _y_frac_max);
 
 	getV4Ldevices();
 }
@@ -70,6 +86,7 @@ V4L2Grabber::V4L2Grabber(const std::string & device
 V4L2Grabber::~V4L2Grabber()
 {
 	uninit();
+	delete _mjpegDecoder;
 }
 
 void V4L2Grabber::uninit()
@@ -185,11 +202,67 @@ void V4L2Grabber::getV4Ldevices()
 void V4L2Grabber::setCropping(int cropLeft, int cropRight, int cropTop, int cropBottom)
 {
 	_imageResampler.setCropping(cropLeft, cropRight, cropTop, cropBottom);
+
+	_cropLeft   = cropLeft;
+	_cropRight  = cropRight;
+	_cropTop    = cropTop;
+	_cropBottom = cropBottom;
+	updatePixelDecimation();
 }
 
 void V4L2Grabber::set3D(VideoMode mode)
 {
 	_imageResampler.set3D(mode);
+	_mjpegResampler.set3D(mode);
+}
+
+void V4L2Grabber::setPixelAveraging(bool enable)
+{
+	_imageResampler.setAveraging(enable);
+	_mjpegResampler.setAveraging(enable);
+}
+
+void V4L2Grabber::setTargetSize(int width, int height)
+{
+	_targetWidth  = width;
+	_targetHeight = height;
+	updatePixelDecimation();
+}
+
+void V4L2Grabber::updatePixelDecimation()
+{
+	// the capture resolution is known once the device is initialized
+	if (_targetWidth > 0 && _targetHeight > 0 && _width > 0 && _height > 0)
+	{
+		_horizontalPixelDecimation = std::max(1, (_width  - _cropLeft - _cropRight)  / _targetWidth);
+		_verticalPixelDecimation   = std::max(1, (_height - _cropTop  - _cropBottom) / _targetHeight);
+		_imageResampler.setHorizontalPixelDecimation(_horizontalPixelDecimation);
+		_imageResampler.setVerticalPixelDecimation(_verticalPixelDecimation);
+		Info(_log, "Pixel decimation %dx%d for a capture size of %dx%d", _horizontalPixelDecimation, _verticalPixelDecimation, _targetWidth, _targetHeight);
+	}
+	updateMjpegResampler();
+}
+
+void V4L2Grabber::updateMjpegResampler()
+{
+	// the decoder downscales by the largest factor both decimations allow
+	_mjpegScale = MjpegDecoder::scaleForDecimation(std::min(_horizontalPixelDecimation, _verticalPixelDecimation));
+
+	_mjpegResampler.setHorizontalPixelDecimation(std::max(1, _horizontalPixelDecimation / int(_mjpegScale)));
+	_mjpegResampler.setVerticalPixelDecimation(std::max(1, _verticalPixelDecimation / int(_mjpegScale)));
+	_mjpegResampler.setCropping(_cropLeft / _mjpegScale, _cropRight / _mjpegScale, _cropTop / _mjpegScale, _cropBottom / _mjpegScale);
+}
+
+int V4L2Grabber::planarChromaOffset(unsigned sizeImage) const
+{
+	// the luma plane is followed by half of its size of chroma
+	const int planeHeight = int(((uint64_t(sizeImage) * 2) / 3) / unsigned(_lineLength));
+	if (planeHeight > _height)
+	{
+		Debug(_log, "Luma plane padded to %d rows", planeHeight);
+		return _lineLength * planeHeight;
+	}
+	return _lineLength * _height;
 }
 
 void V4L2Grabber::setSignalThreshold(double redSignalThreshold, double greenSignalThreshold, double blueSignalThreshold, int noSignalCounterThreshold)
@@ -213,6 +286,7 @@ void V4L2Grabber::setSignalDetectionOffset(double horizontalMin, double vertical
 	_y_frac_min = verticalMin;
 	_x_frac_max = horizontalMax;
 	_y_frac_max = verticalMax;
+	_imageStatistics.setCenterRegion(_x_frac_min, _y_frac_min, _x_frac_max, _y_frac_max);
 
 	Info(_log, "Signal detection area set to: %f,%f x %f,%f", _x_frac_min, _y_frac_min, _x_frac_max, _y_frac_max );
 }
@@ -501,9 +575,22 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 	case PIXELFORMAT_YUYV:
 		fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
 		break;
+	case PIXELFORMAT_NV12:
+		fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_NV12;
+		break;
+	case PIXELFORMAT_I420:
+		fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUV420;
+		break;
 	case PIXELFORMAT_RGB32:
 		fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_RGB32;
 		break;
+	case PIXELFORMAT_MJPEG:
+		if (!MjpegDecoder::available())
+		{
+			throw_exception("MJPEG is not supported, hyperion is built without libjpeg");
+		}
+		fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;
+		break;
 	case PIXELFORMAT_NO_CHANGE:
 	default:
 		// No change to device settings
@@ -524,9 +611,6 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 		}
 	}
 
-	// set the line length
-	_lineLength = fmt.fmt.pix.bytesperline;
-
 	// set the settings
 	if (-1 == xioctl(VIDIOC_S_FMT, &fmt))
 	{
@@ -540,9 +624,12 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 		throw_errno_exception("VIDIOC_G_FMT");
 	}
 
-	// store width & height
+	// store width & height and the line length of the accepted format (of the luma plane for planar formats)
 	_width = fmt.fmt.pix.width;
 	_height = fmt.fmt.pix.height;
+	_lineLength = fmt.fmt.pix.bytesperline;
+	_chromaOffset = 0;
+	updatePixelDecimation();
 
 	// display the used width and height
 	Debug(_log, "width=%d height=%d", _width, _height );
@@ -561,13 +648,37 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 		_frameByteSize = _width * _height * 2;
 		Debug(_log, "Pixel format=YUYV");
 		break;
+	case V4L2_PIX_FMT_NV12:
+		_pixelFormat = PIXELFORMAT_NV12;
+		_lineLength = std::max(_lineLength, _width);
+		_chromaOffset = planarChromaOffset(fmt.fmt.pix.sizeimage);
+		_frameByteSize = (_chromaOffset * 3) / 2;
+		Debug(_log, "Pixel format=NV12, chroma offset=%d", _chromaOffset);
+		break;
+	case V4L2_PIX_FMT_YUV420:
+		_pixelFormat = PIXELFORMAT_I420;
+		_lineLength = std::max(_lineLength, _width);
+		_chromaOffset = planarChromaOffset(fmt.fmt.pix.sizeimage);
+		_frameByteSize = (_chromaOffset * 3) / 2;
+		Debug(_log, "Pixel format=I420, chroma offset=%d", _chromaOffset);
+		break;
 	case V4L2_PIX_FMT_RGB32:
 		_pixelFormat = PIXELFORMAT_RGB32;
 		_frameByteSize = _width * _height * 4;
 		Debug(_log, "Pixel format=RGB32");
 		break;
+	case V4L2_PIX_FMT_MJPEG:
+		if (!MjpegDecoder::available())
+		{
+			throw_exception("MJPEG is not supported, hyperion is built without libjpeg");
+		}
+		_pixelFormat = PIXELFORMAT_MJPEG;
+		// the size of the compressed frames varies
+		_frameByteSize = -1;
+		Debug(_log, "Pixel format=MJPEG, decoded at 1/%d of the size", _mjpegScale);
+		break;
 	default:
-		throw_exception("Only pixel formats UYVY, YUYV, and RGB32 are supported");
+		throw_exception("Only pixel formats UYVY, YUYV, NV12, I420, RGB32 and MJPEG are supported");
 	}
 
 	switch (_ioMethod) {
@@ -791,13 +902,15 @@ bool V4L2Grabber::process_image(const void *p, int size)
 	if (++_currentFrame >= _frameDecimation)
 	{
 		// We do want a new frame...
-		if (size != _frameByteSize)
+		// planar frames may carry padding after the chroma planes, all other formats have an exact size
+		const bool planar = (_pixelFormat == PIXELFORMAT_NV12 || _pixelFormat == PIXELFORMAT_I420);
+		if (_pixelFormat == PIXELFORMAT_MJPEG ? size <= 0 : (planar ? size < _frameByteSize : size != _frameByteSize))
 		{
 			Error(_log, "Frame too small: %d != %d", size, _frameByteSize);
 		}
 		else
 		{
-			process_image(reinterpret_cast<const uint8_t *>(p));
+			process_image(reinterpret_cast<const uint8_t *>(p), size);
 			_currentFrame = 0; // restart counting
 			return true;
 		}
@@ -806,30 +919,25 @@ bool V4L2Grabber::process_image(const void *p, int size)
 	return false;
 }
 
-void V4L2Grabber::process_image(const uint8_t * data)
+void V4L2Grabber::process_image(const uint8_t * data, int size)
 {
 	Image<ColorRgb> image(0, 0);
-	_imageResampler.processImage(data, _width, _height, _lineLength, _pixelFormat, image);
-
-	// check signal (only in center of the resulting image, because some grabbers have noise values along the borders)
-	bool noSignal = true;
-
-	// top left
-	unsigned xOffset  = image.width()  * _x_frac_min;
-	unsigned yOffset  = image.height() * _y_frac_min;
-
-	// bottom right
-	unsigned xMax     = image.width()  * _x_frac_max;
-	unsigned yMax     = image.height() * _y_frac_max;
-
-	
-	for (unsigned x = xOffset; noSignal && x < xMax; ++x)
+	if (_pixelFormat == PIXELFORMAT_MJPEG)
 	{
-		for (unsigned y = yOffset; noSignal && y < yMax; ++y)
+		if (!_mjpegDecoder->decode(data, size, _mjpegScale))
 		{
-			noSignal &= (ColorRgb&)image(x, y) <= _noSignalThresholdColor;
+			Error(_log, "Could not decode the MJPEG frame: %s", _mjpegDecoder->error().c_str());
+			return;
 		}
+		_mjpegResampler.processImage(_mjpegDecoder->pixels(), _mjpegDecoder->width(), _mjpegDecoder->height(), _mjpegDecoder->width() * 3, PIXELFORMAT_RGB24, image);
 	}
+	else
+	{
+		_imageResampler.processImage(data, _width, _height, _lineLength, _pixelFormat, image, _chromaOffset);
+	}
+
+	// check signal (only in center of the resulting image, because some grabbers have noise values along the borders)
+	const bool noSignal = !_imageStatistics.centerExceeds(image, _noSignalThresholdColor);
 
 	if (noSignal)
 	{
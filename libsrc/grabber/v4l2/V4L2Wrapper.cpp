@@ -49,8 +49,7 @@ V4L2Wrapper::V4L2Wrapper(const std::string &device,
 // 				Qt::QueuedConnection);
 
 	
-	// setup the higher prio source checker
-	// this will disable the v4l2 grabber when a source with higher priority is active
+	// the frames are delivered by the grabber, the timer only runs while the grabber is enabled
 	_timer.setInterval(500);
 }
 
@@ -85,12 +84,25 @@ void V4L2Wrapper::set3D(VideoMode mode)
 	_grabber.set3D(mode);
 }
 
+void V4L2Wrapper::setPixelAveraging(bool enable)
+{
+	_grabber.setPixelAveraging(enable);
+}
+
+void V4L2Wrapper::setTargetSize(int width, int height)
+{
+	_grabber.setTargetSize(width, height);
+}
+
 void V4L2Wrapper::newFrame(const Image<ColorRgb> &image)
 {
 	emit emitImage(_priority, image, _timeout_ms);
 
-	// process the new image
-	_processor->process(image, _ledColors);
+	// map the image only if it changed, the previous colors are set again otherwise
+	if (imageChanged(image.signature()))
+	{
+		_processor->process(image, _ledColors);
+	}
 	setColors(_ledColors, _timeout_ms);
 }
 
@@ -100,25 +112,19 @@ void V4L2Wrapper::readError(const char* err)
 	stop();
 }
 	
-void V4L2Wrapper::checkSources()
+void V4L2Wrapper::setSuspended(bool suspended)
 {
-	QList<int> activePriorities = _hyperion->getActivePriorities();
-
-	for (int x : activePriorities)
+	if (suspended)
 	{
-		if (x < _priority)
-		{
-			// found a higher priority source: grabber should be disabled
-			_grabber.stop();
-			return;
-		}
+		_grabber.stop();
+	}
+	else
+	{
+		_grabber.start();
 	}
-
-	// no higher priority source was found: grabber should be enabled
-	_grabber.start();
 }
 
 void V4L2Wrapper::action()
 {
-	checkSources();
+	// the frames are delivered by the grabber (newFrame)
 }
@@ -1,11 +1,18 @@
 // STL includes
 #include <iostream>
 #include <cstdint>
+#include <algorithm>
+#include <cstring>
 #include <utils/Logger.h>
 
 // X11Grabber includes
 #include <grabber/X11Grabber.h>
 
+#ifdef ENABLE_XDAMAGE
+	#include <X11/extensions/Xdamage.h>
+	#include <X11/extensions/Xfixes.h>
+#endif
+
 X11Grabber::X11Grabber(bool useXGetImage, int cropLeft, int cropRight, int cropTop, int cropBottom, int horizontalPixelDecimation, int verticalPixelDecimation)
 	: _imageResampler()
 	, _useXGetImage(useXGetImage)
@@ -21,11 +28,22 @@ X11Grabber::X11Grabber(bool useXGetImage, int cropLeft, int cropRight, int cropT
 	, _dstPicture(None)
 	, _horizontalDecimation(horizontalPixelDecimation)
 	, _verticalDecimation(verticalPixelDecimation)
+	, _targetWidth(0)
+	, _targetHeight(0)
 	, _screenWidth(0)
 	, _screenHeight(0)
 	, _croppedWidth(0)
 	, _croppedHeight(0)
 	, _image(0,0)
+	, _videoMode(VIDEO_2D)
+	, _useXDamage(false)
+	, _XDamageAvailable(false)
+	, _damageRegionsOnly(false)
+	, _damageEventBase(0)
+	, _damage(None)
+	, _damageRegion(None)
+	, _damageFull(true)
+	, _damageImage(0,0)
 	, _log(Logger::getInstance("X11GRABBER"))
 {
 	_imageResampler.setCropping(0, 0, 0, 0); // cropping is performed by XRender, XShmGetImage or XGetImage
@@ -38,6 +56,13 @@ X11Grabber::~X11Grabber()
 	if (_x11Display != nullptr)
 	{
 		freeResources();
+#ifdef ENABLE_XDAMAGE
+		if (_XDamageAvailable)
+		{
+			XFixesDestroyRegion(_x11Display, _damageRegion);
+			XDamageDestroy(_x11Display, _damage);
+		}
+#endif
 		XCloseDisplay(_x11Display);
 	}
 }
@@ -45,6 +70,20 @@ X11Grabber::~X11Grabber()
 void X11Grabber::setVideoMode(const VideoMode videoMode)
 {
 	_imageResampler.set3D(videoMode);
+	_videoMode  = videoMode;
+	_damageFull = true;
+}
+
+void X11Grabber::setTargetSize(const unsigned width, const unsigned height)
+{
+	_targetWidth  = width;
+	_targetHeight = height;
+}
+
+void X11Grabber::setDamageTracking(const bool enable, const bool regionsOnly)
+{
+	_useXDamage        = enable;
+	_damageRegionsOnly = regionsOnly;
 }
 
 void X11Grabber::freeResources()
@@ -126,6 +165,23 @@ bool X11Grabber::Setup()
 	_imageResampler.setHorizontalPixelDecimation(_XRenderAvailable ? 1 : _horizontalDecimation);
 	_imageResampler.setVerticalPixelDecimation(_XRenderAvailable ? 1 : _verticalDecimation);
 
+#ifdef ENABLE_XDAMAGE
+	int damageError, major, minor;
+	_XDamageAvailable = _useXDamage
+		&& XDamageQueryExtension(_x11Display, &_damageEventBase, &damageError)
+		&& XDamageQueryVersion(_x11Display, &major, &minor)
+		&& XFixesQueryVersion(_x11Display, &major, &minor);
+	if (_XDamageAvailable)
+	{
+		// a notification is sent when the damage becomes non-empty, it is reset after every grab
+		_damage       = XDamageCreate(_x11Display, _window, XDamageReportNonEmpty);
+		_damageRegion = XFixesCreateRegion(_x11Display, nullptr, 0);
+		_damageFull   = true;
+		Info(_log, "Using XDamage to skip unchanged frames");
+	}
+#endif
+	WarningIf(_useXDamage && !_XDamageAvailable, _log, "XDamage is not available, every frame is grabbed");
+
 	return true;
 }
 
@@ -209,8 +265,76 @@ Image<ColorRgb> & X11Grabber::grab()
 	return _image;
 }
 
+bool X11Grabber::fetchDamage(XRectangle & bounds)
+{
+	bounds = { 0, 0, (unsigned short)_screenWidth, (unsigned short)_screenHeight };
+#ifdef ENABLE_XDAMAGE
+	// the notifications are read without a round-trip to the X server
+	bool damaged = false;
+	XEvent event;
+	while (XCheckTypedEvent(_x11Display, _damageEventBase + XDamageNotify, &event))
+	{
+		damaged = true;
+	}
+	if (!damaged && !_damageFull)
+	{
+		return false;
+	}
+
+	// reset the damage, damage after this point triggers a new notification
+	XDamageSubtract(_x11Display, _damage, None, _damageRegion);
+	XRectangle damageBounds;
+	int count = 0;
+	XRectangle * rectangles = XFixesFetchRegionAndBounds(_x11Display, _damageRegion, &count, &damageBounds);
+	if (rectangles != nullptr)
+	{
+		XFree(rectangles);
+	}
+
+	if (!_damageFull && _damageRegionsOnly)
+	{
+		bounds = damageBounds;
+		if (count == 0)
+		{
+			return false;
+		}
+	}
+	_damageFull = false;
+#endif
+	return true;
+}
+
 int X11Grabber::grabFrame(Image<ColorRgb> & image)
 {
+	// the size of the cropped screen, before scaling
+	const int screenWidth  = (_screenWidth  > unsigned(_cropLeft + _cropRight))  ? (_screenWidth  - _cropLeft - _cropRight)  : _screenWidth;
+	const int screenHeight = (_screenHeight > unsigned(_cropTop  + _cropBottom)) ? (_screenHeight - _cropTop  - _cropBottom) : _screenHeight;
+
+	// the damaged area of the cropped screen, the whole area without damage tracking
+	int left = 0, top = 0, right = screenWidth, bottom = screenHeight;
+	if (_XDamageAvailable)
+	{
+		XRectangle bounds;
+		if (!fetchDamage(bounds))
+		{
+			return 1;
+		}
+		left   = std::max(int(bounds.x) - _cropLeft, 0);
+		top    = std::max(int(bounds.y) - _cropTop, 0);
+		right  = std::min(int(bounds.x) + int(bounds.width)  - _cropLeft, screenWidth);
+		bottom = std::min(int(bounds.y) + int(bounds.height) - _cropTop,  screenHeight);
+		if (left >= right || top >= bottom)
+		{
+			// only the cropped borders changed
+			return 1;
+		}
+	}
+
+	// the output rows to re-sample
+	int rowBegin = 0;
+	int rowEnd = image.height();
+	int resamplerDecimation = 1;
+
 	if (_XRenderAvailable && !_useXGetImage)
 	{
 		double scale_x = static_cast<double>(_windowAttr.width / _horizontalDecimation) / static_cast<double>(_windowAttr.width);
@@ -239,20 +363,28 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image)
 		};
 		
 		XRenderSetPictureTransform (_x11Display, _srcPicture, &_transform);
+
+		// the damaged area in the scaled image, with a margin for the bilinear filter
+		const int dstLeft   = std::max(int(left * scale) - 1, 0);
+		const int dstTop    = std::max(int(top  * scale) - 1, 0);
+		const int dstRight  = std::min(int(right  * scale) + 2, int(_croppedWidth));
+		const int dstBottom = std::min(int(bottom * scale) + 2, int(_croppedHeight));
+		rowBegin = dstTop;
+		rowEnd   = dstBottom;
 		
 		XRenderComposite( _x11Display,					// dpy
 					PictOpSrc,				// op
 					_srcPicture,				// src
 					None,					// mask
 					_dstPicture,				// dst
-					_cropLeft / _horizontalDecimation,	// src_x _cropLeft
-					_cropTop / _verticalDecimation,		// src_y _cropTop
+					_cropLeft / _horizontalDecimation + dstLeft,	// src_x _cropLeft
+					_cropTop / _verticalDecimation + dstTop,	// src_y _cropTop
 					0,					// mask_x
 					0,					// mask_y
-					0,					// dst_x
-					0,					// dst_y
-					_croppedWidth,				// width
-					_croppedHeight);			// height
+					dstLeft,				// dst_x
+					dstTop,					// dst_y
+					dstRight - dstLeft,			// width
+					dstBottom - dstTop);			// height
     
 		XSync(_x11Display, False);
 		
@@ -267,6 +399,10 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image)
 	}
 	else
 	{
+		resamplerDecimation = _verticalDecimation;
+		rowBegin = top / _verticalDecimation;
+		rowEnd   = (bottom + _verticalDecimation - 1) / _verticalDecimation;
+
 		if (_XShmAvailable && !_useXGetImage) {
 			XShmGetImage(_x11Display, _window, _xImage, _cropLeft, _cropTop, AllPlanes);
 		}
@@ -282,6 +418,20 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image)
 		return -1;
 	}
 
+	// re-sample only the damaged rows, the image holds the previous frame
+	const int outputHeight = image.height();
+	rowEnd = std::min(rowEnd, outputHeight);
+	if (_XDamageAvailable && _videoMode == VIDEO_2D && (rowBegin > 0 || rowEnd < outputHeight))
+	{
+		const uint8_t * rows = reinterpret_cast<const uint8_t *>(_xImage->data) + size_t(rowBegin) * resamplerDecimation * _xImage->bytes_per_line;
+		_imageResampler.processImage(rows, _xImage->width, (rowEnd - rowBegin) * resamplerDecimation, _xImage->bytes_per_line, PIXELFORMAT_BGR32, _damageImage);
+		if (_damageImage.width() == image.width() && _damageImage.height() == unsigned(rowEnd - rowBegin))
+		{
+			memcpy(&image(0, rowBegin), _damageImage.memptr(), size_t(_damageImage.width()) * _damageImage.height() * sizeof(ColorRgb));
+			return 0;
+		}
+	}
+
 	_imageResampler.processImage(reinterpret_cast<const uint8_t *>(_xImage->data), _xImage->width, _xImage->height, _xImage->bytes_per_line, PIXELFORMAT_BGR32, image);
 
 	return 0;
@@ -310,6 +460,18 @@ int X11Grabber::updateScreenDimensions()
 	Info(_log, "Update of screen resolution: [%dx%d]  to [%dx%d]", _screenWidth, _screenHeight, _windowAttr.width, _windowAttr.height);
 	_screenWidth  = _windowAttr.width;
 	_screenHeight = _windowAttr.height;
+
+	// derive the decimation from the size the led layout needs
+	if (_targetWidth > 0 && _targetHeight > 0)
+	{
+		const int width  = std::max(1, int(_screenWidth)  - _cropLeft - _cropRight);
+		const int height = std::max(1, int(_screenHeight) - _cropTop  - _cropBottom);
+		_horizontalDecimation = std::max(1, width  / int(_targetWidth));
+		_verticalDecimation   = std::max(1, height / int(_targetHeight));
+		_imageResampler.setHorizontalPixelDecimation(_XRenderAvailable ? 1 : _horizontalDecimation);
+		_imageResampler.setVerticalPixelDecimation(_XRenderAvailable ? 1 : _verticalDecimation);
+		Info(_log, "Pixel decimation %dx%d for a capture size of %dx%d", _horizontalDecimation, _verticalDecimation, _targetWidth, _targetHeight);
+	}
 	
 	// Image scaling is performed by XRender when available, otherwise by ImageResampler
 	if (_XRenderAvailable && !_useXGetImage)
@@ -339,6 +501,7 @@ int X11Grabber::updateScreenDimensions()
 
 	_image.resize(_croppedWidth, _croppedHeight);
 	setupResources();
+	_damageFull = true;
 
 	return 1;
 }
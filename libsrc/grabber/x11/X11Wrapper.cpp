@@ -25,6 +25,16 @@ X11Wrapper::~X11Wrapper()
 	delete _grabber;
 }
 
+void X11Wrapper::setTargetSize(const unsigned width, const unsigned height)
+{
+	_grabber->setTargetSize(width, height);
+}
+
+void X11Wrapper::setDamageTracking(const bool enable, const bool regionsOnly)
+{
+	_grabber->setDamageTracking(enable, regionsOnly);
+}
+
 bool X11Wrapper::start()
 {
 	if (! _init )
@@ -62,11 +72,21 @@ void X11Wrapper::action()
 		_image.resize(_grabber->getImageWidth(), _grabber->getImageHeight());
 	}
 	// Grab frame into the allocated image
-	_grabber->grabFrame(_image);
+	const int grabResult = _grabber->grabFrame(_image);
+	if (grabResult < 0)
+	{
+		return;
+	}
 
+	// the kept image of an unchanged screen (damage tracking) is emitted again, so the other
+	// instances and the proto slaves keep their channel; sharing the image copies no pixels
 	emit emitImage(_priority, _image, _timeout_ms);
 
-	_processor->process(_image, _ledColors);
+	// map the image only if it changed, the previous colors are set again otherwise
+	if (grabResult == 0 && imageChanged(_image.signature()))
+	{
+		_processor->process(_image, _ledColors);
+	}
 	setColors(_ledColors, _timeout_ms);
 }
 
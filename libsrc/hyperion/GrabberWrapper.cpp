@@ -4,7 +4,20 @@
 #include <hyperion/GrabberWrapper.h>
 #include <HyperionConfig.h>
 
+// Qt includes
+#include <QDateTime>
+
 #define QSTRING_CSTR(str) str.toLocal8Bit().constData()
+
+namespace
+{
+	/// interval to map an unchanged image again anyway [ms]
+	const int64_t IMAGE_REMAP_INTERVAL_MS = 1000;
+
+	/// interval to refresh the led colors of a suspended grabber [ms]
+	const int IDLE_INTERVAL_MS = 500;
+}
+
 GrabberWrapper::GrabberWrapper(QString grabberName, const int priority, hyperion::Components grabberComponentId)
 	: _grabberName(grabberName)
 	, _hyperion(Hyperion::getInstance())
@@ -14,6 +27,14 @@ GrabberWrapper::GrabberWrapper(QString grabberName, const int priority, hyperion
 	, _forward(true)
 	, _processor(ImageProcessorFactory::getInstance().newImageProcessor())
 	, _grabberComponentId(grabberComponentId)
+	, _visiblePriorities()
+	, _suspended(false)
+	, _grabInterval(0)
+	, _lastLedColors()
+	, _imageSignature(0)
+	, _imageMappingType(-1)
+	, _imageBlackBorderEnabled(false)
+	, _imageMappingTime(0)
 {
 	_timer.setSingleShot(false);
 
@@ -23,7 +44,9 @@ GrabberWrapper::GrabberWrapper(QString grabberName, const int priority, hyperion
 
 	connect(_hyperion, SIGNAL(imageToLedsMappingChanged(int)), _processor, SLOT(setLedMappingType(int))); 
 	connect(_hyperion, SIGNAL(componentStateChanged(hyperion::Components,bool)), this, SLOT(componentStateChanged(hyperion::Components,bool)));
-	connect(&_timer, SIGNAL(timeout()), this, SLOT(action()));
+	connect(&_timer, SIGNAL(timeout()), this, SLOT(timerAction()));
+
+	trackVisiblePriority(_hyperion);
 }
 
 GrabberWrapper::~GrabberWrapper()
@@ -38,6 +61,7 @@ bool GrabberWrapper::start()
 	// Start the timer with the pre configured interval
 	_timer.start();
 	_hyperion->registerPriority(_grabberName.toStdString(), _priority);
+	updateSuspension();
 	return _timer.isActive();
 
 }
@@ -47,6 +71,64 @@ void GrabberWrapper::stop()
 	// Stop the timer, effectivly stopping the process
 	_timer.stop();
 	_hyperion->unRegisterPriority(_grabberName.toStdString());
+
+	// the grabber is started unsuspended again
+	if (_suspended)
+	{
+		_suspended = false;
+		_timer.setInterval(_grabInterval);
+	}
+}
+
+void GrabberWrapper::trackVisiblePriority(Hyperion * hyperion)
+{
+	_visiblePriorities[hyperion] = hyperion->getCurrentPriority();
+	connect(hyperion, SIGNAL(visiblePriorityChanged(int)), this, SLOT(visiblePriorityChanged(int)));
+	updateSuspension();
+}
+
+void GrabberWrapper::visiblePriorityChanged(int priority)
+{
+	_visiblePriorities[sender()] = priority;
+	updateSuspension();
+}
+
+void GrabberWrapper::updateSuspension()
+{
+	// the images are forwarded to the proto slaves regardless of the visible priority
+	bool hidden = _timer.isActive() && !_forward;
+	for (int priority : _visiblePriorities)
+	{
+		hidden = hidden && priority < _priority;
+	}
+
+	if (hidden != _suspended)
+	{
+		if (hidden)
+		{
+			_grabInterval = _timer.interval();
+		}
+		_suspended = hidden;
+		_timer.setInterval(hidden ? IDLE_INTERVAL_MS : _grabInterval);
+		Info(_log, "grabber %s", (hidden ? "suspended, a higher priority is visible" : "resumed"));
+		setSuspended(hidden);
+	}
+}
+
+void GrabberWrapper::setSuspended(bool suspended)
+{
+}
+
+void GrabberWrapper::timerAction()
+{
+	if (!_suspended)
+	{
+		action();
+	}
+	else if (!_lastLedColors.empty())
+	{
+		_hyperion->setColors(_priority, _lastLedColors, 2 * IDLE_INTERVAL_MS, true, _grabberComponentId);
+	}
 }
 
 void GrabberWrapper::componentStateChanged(const hyperion::Components component, bool enable)
@@ -104,9 +186,32 @@ void GrabberWrapper::setGrabbingMode(const GrabbingMode mode)
 
 void GrabberWrapper::setColors(const std::vector<ColorRgb> &ledColors, const int timeout_ms)
 {
+	_lastLedColors = ledColors;
 	_hyperion->setColors(_priority, ledColors, timeout_ms, true, _grabberComponentId);
 }
 
+bool GrabberWrapper::imageChanged(const uint64_t signature)
+{
+	const int64_t now = QDateTime::currentMSecsSinceEpoch();
+	const int mappingType = _processor->ledMappingType();
+	const bool blackBorderEnabled = _processor->blackBorderDetectorEnabled();
+
+	if (_imageMappingTime != 0
+		&& signature == _imageSignature
+		&& mappingType == _imageMappingType
+		&& blackBorderEnabled == _imageBlackBorderEnabled
+		&& now - _imageMappingTime < IMAGE_REMAP_INTERVAL_MS)
+	{
+		return false;
+	}
+
+	_imageSignature          = signature;
+	_imageMappingType        = mappingType;
+	_imageBlackBorderEnabled = blackBorderEnabled;
+	_imageMappingTime        = now;
+	return true;
+}
+
 QStringList GrabberWrapper::availableGrabbers()
 {
 	QStringList grabbers;
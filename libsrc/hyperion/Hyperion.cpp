@@ -1,6 +1,7 @@
 
 // STL includes
 #include <cassert>
+#include <cmath>
 #include <exception>
 #include <sstream>
 
@@ -51,6 +52,14 @@ Hyperion* Hyperion::getInstance()
 	return Hyperion::_hyperion;
 }
 
+Hyperion* Hyperion::createInstance(const QString & name, const QJsonObject& qjsonConfig, const QString configFile)
+{
+	if ( name.isEmpty() )
+		throw std::runtime_error("Hyperion::createInstance needs the name of the instance");
+
+	return new Hyperion(qjsonConfig, configFile, name);
+}
+
 ColorOrder Hyperion::createColorOrder(const QJsonObject &deviceConfig)
 {
 	return stringToColorOrder(deviceConfig["colorOrder"].toString("rgb"));
@@ -315,7 +324,31 @@ QSize Hyperion::getLedLayoutGridSize(const QJsonValue& ledsConfig)
 	return gridSize;
 }
 
+QSize Hyperion::getLedLayoutImageSize(const LedString & ledString)
+{
+	int width  = 1;
+	int height = 1;
 
+	for (const Led& led : ledString.leds())
+	{
+		const double widthFrac  = led.maxX_frac - led.minX_frac;
+		const double heightFrac = led.maxY_frac - led.minY_frac;
+
+		// skip leds without area
+		if (widthFrac < 1e-6 || heightFrac < 1e-6)
+		{
+			continue;
+		}
+
+		width  = std::max(width,  int(std::ceil(LED_AREA_MIN_PIXELS / widthFrac)));
+		height = std::max(height, int(std::ceil(LED_AREA_MIN_PIXELS / heightFrac)));
+	}
+
+	QSize imageSize(width, height);
+	Debug(CORE_LOGGER, "led layout image size: %dx%d", imageSize.width(), imageSize.height());
+
+	return imageSize;
+}
 
 LinearColorSmoothing * Hyperion::createColorSmoothing(const QJsonObject & smoothingConfig, LedDevice* leddevice)
 {
@@ -381,8 +414,9 @@ MessageForwarder * Hyperion::getForwarder()
 	return _messageForwarder;
 }
 
-Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile)
-	: _ledString(createLedString(qjsonConfig["leds"], createColorOrder(qjsonConfig["device"].toObject())))
+Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile, const QString name)
+	: _name(name)
+	, _ledString(createLedString(qjsonConfig["leds"], createColorOrder(qjsonConfig["device"].toObject())))
 	, _ledStringClone(createLedStringClone(qjsonConfig["leds"], createColorOrder(qjsonConfig["device"].toObject())))
 	, _muxer(_ledString.leds().size())
 	, _raw2ledAdjustment(createLedColorsAdjustment(_ledString.leds().size(), qjsonConfig["color"].toObject()))
@@ -391,11 +425,16 @@ Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile)
 	, _qjsonConfig(qjsonConfig)
 	, _configFile(configFile)
 	, _timer()
-	, _log(CORE_LOGGER)
+	, _lastWriteSmoothed(false)
+	, _lastWriteTime(0)
+	, _log(name.isEmpty() ? CORE_LOGGER : Logger::getInstance("Core-" + name))
 	, _hwLedCount(_ledString.leds().size())
 	, _sourceAutoSelectEnabled(true)
+	, _visiblePriority(PriorityMuxer::LOWEST_PRIORITY)
 	, _configHash()
 	, _ledGridSize(getLedLayoutGridSize(qjsonConfig["leds"]))
+	, _ledImageSize(getLedLayoutImageSize(_ledString))
+	, _ledLayoutHash(_ledString.layoutHash())
 	, _prevCompId(hyperion::COMP_INVALID)
 {
 	registerPriority("Off", PriorityMuxer::LOWEST_PRIORITY);
@@ -407,9 +446,12 @@ Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile)
 	// set color correction activity state
 	const QJsonObject& color = qjsonConfig["color"].toObject();
 	
-	// initialize the image processor factory
+	// initialize the image processor factory, the additional instances map the images on their own
 	_ledMAppingType = ImageProcessor::mappingTypeToInt(color["imageToLedMappingType"].toString());
-	ImageProcessorFactory::getInstance().init(_ledString, qjsonConfig["blackborderdetector"].toObject(),_ledMAppingType );
+	if (_name.isEmpty())
+	{
+		ImageProcessorFactory::getInstance().init(_ledString, qjsonConfig["blackborderdetector"].toObject(),_ledMAppingType );
+	}
 	
 	getComponentRegister().componentStateChanged(hyperion::COMP_FORWARDER, _messageForwarder->forwardingEnabled());
 
@@ -422,8 +464,11 @@ Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile)
 	_timer.setSingleShot(true);
 	QObject::connect(&_timer, SIGNAL(timeout()), this, SLOT(update()));
 
-	// create the effect engine
-	_effectEngine = new EffectEngine(this,qjsonConfig["effects"].toObject());
+	// create the effect engine, the python interpreter exists once per process
+	if (_name.isEmpty())
+	{
+		_effectEngine = new EffectEngine(this,qjsonConfig["effects"].toObject());
+	}
 	
 	const QJsonObject& device = qjsonConfig["device"].toObject();
 	unsigned int hwLedCount = device["ledCount"].toInt(getLedCount());
@@ -431,7 +476,7 @@ Hyperion::Hyperion(const QJsonObject &qjsonConfig, const QString configFile)
 	Debug(_log,"configured leds: %d hw leds: %d", getLedCount(), _hwLedCount);
 	WarningIf(hwLedCount < getLedCount(), _log, "more leds configured than available. check 'ledCount' in 'device' section");
 
-	WarningIf(!configWriteable(), _log, "Your config is not writeable - you won't be able to use the web ui for configuration.");
+	WarningIf(_name.isEmpty() && !configWriteable(), _log, "Your config is not writeable - you won't be able to use the web ui for configuration.");
 	// initialize hash of current config
 	configModified();
 
@@ -453,6 +498,7 @@ void Hyperion::freeObjects(bool emitCloseSignal)
 	// switch off all leds
 	clearall();
 	_device->switchOff();
+	_lastLedBuffer.clear();
 
 	// delete components on exit of hyperion core
 	delete _effectEngine;
@@ -554,6 +600,7 @@ void Hyperion::setComponentState(const hyperion::Components component, const boo
 	if (component == hyperion::COMP_SMOOTHING)
 	{
 		_deviceSmooth->setEnable(state);
+		_lastLedBuffer.clear();
 		getComponentRegister().componentStateChanged(hyperion::COMP_SMOOTHING, _deviceSmooth->componentState());
 	}
 	else
@@ -574,7 +621,7 @@ void Hyperion::setColor(int priority, const ColorRgb &color, const int timeout_m
 void Hyperion::setColors(int priority, const std::vector<ColorRgb>& ledColors, const int timeout_ms, bool clearEffects, hyperion::Components component)
 {
 	// clear effects if this call does not come from an effect
-	if (clearEffects)
+	if (clearEffects && _effectEngine != nullptr)
 	{
 		_effectEngine->channelCleared(priority);
 	}
@@ -637,7 +684,10 @@ void Hyperion::clear(int priority)
 
 	// send clear signal to the effect engine
 	// (outside the check so the effect gets cleared even when the effect is not sending colors)
-	_effectEngine->channelCleared(priority);
+	if (_effectEngine != nullptr)
+	{
+		_effectEngine->channelCleared(priority);
+	}
 }
 
 void Hyperion::clearall()
@@ -649,7 +699,10 @@ void Hyperion::clearall()
 	update();
 
 	// send clearall signal to the effect engine
-	_effectEngine->allChannelsCleared();
+	if (_effectEngine != nullptr)
+	{
+		_effectEngine->allChannelsCleared();
+	}
 }
 
 int Hyperion::getCurrentPriority() const
@@ -712,6 +765,11 @@ void Hyperion::update()
 	// Obtain the current priority channel
 	int priority = _sourceAutoSelectEnabled || !_muxer.hasPriority(_currentSourcePriority) ? _muxer.getCurrentPriority() : _currentSourcePriority;
 	const PriorityMuxer::InputInfo & priorityInfo  =  _muxer.getInputInfo(priority);
+	if (priority != _visiblePriority)
+	{
+		_visiblePriority = priority;
+		emit visiblePriorityChanged(priority);
+	}
 
 	// copy ledcolors to local buffer
 	_ledBuffer.reserve(_hwLedCount);
@@ -785,20 +843,33 @@ void Hyperion::update()
 		_ledBuffer.resize(_hwLedCount, ColorRgb::BLACK);
 	}
 	
-	// Write the data to the device
-	if (_deviceSmooth->enabled())
-		_deviceSmooth->setLedValues(_ledBuffer);
-	else
-		_device->setLedValues(_ledBuffer);
+	// Write the data to the device, unless the same values were written the same way less than
+	// LED_REWRITE_INTERVAL_MS before
+	const bool smoothed = _deviceSmooth->enabled();
+	const int64_t now = QDateTime::currentMSecsSinceEpoch();
+	if (_ledBuffer != _lastLedBuffer || smoothed != _lastWriteSmoothed || now - _lastWriteTime >= LED_REWRITE_INTERVAL_MS)
+	{
+		const int result = smoothed ? _deviceSmooth->setLedValues(_ledBuffer) : _device->setLedValues(_ledBuffer);
+		if (result >= 0)
+		{
+			_lastLedBuffer     = _ledBuffer;
+			_lastWriteSmoothed = smoothed;
+			_lastWriteTime     = now;
+		}
+		else
+		{
+			_lastLedBuffer.clear();
+		}
+	}
 
-	// Start the timeout-timer
+	// Start the timeout-timer, at least for the rewrite of unchanged led values
 	if (priorityInfo.timeoutTime_ms == -1)
 	{
-		_timer.stop();
+		_timer.start(LED_REWRITE_INTERVAL_MS);
 	}
 	else
 	{
-		int timeout_ms = std::max(0, int(priorityInfo.timeoutTime_ms - QDateTime::currentMSecsSinceEpoch()));
-		_timer.start(timeout_ms);
+		int timeout_ms = std::max(0, int(priorityInfo.timeoutTime_ms - now));
+		_timer.start(std::min(timeout_ms, int(LED_REWRITE_INTERVAL_MS)));
 	}
 }
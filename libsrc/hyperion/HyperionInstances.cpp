@@ -0,0 +1,156 @@
+// STL includes
+#include <algorithm>
+
+// QT includes
+#include <QJsonArray>
+#include <QStringList>
+#include <QRunnable>
+
+// hyperion include
+#include <hyperion/HyperionInstances.h>
+#include <hyperion/Hyperion.h>
+#include <hyperion/ImageProcessorFactory.h>
+#include <hyperion/ImageProcessor.h>
+#include <hyperion/GrabberWrapper.h>
+
+// leddevice includes
+#include <leddevice/LedDevice.h>
+
+///
+/// Maps one image to the leds of one instance on a thread of the mapping pool
+///
+class InstanceMappingTask : public QRunnable
+{
+public:
+	InstanceMappingTask(ImageProcessor * processor, const Image<ColorRgb> & image, std::vector<ColorRgb> & ledColors)
+		: QRunnable()
+		, _processor(processor)
+		, _image(image)
+		, _ledColors(ledColors)
+	{
+		setAutoDelete(true);
+	}
+
+	virtual void run()
+	{
+		_processor->process(_image, _ledColors);
+	}
+
+private:
+	ImageProcessor * _processor;
+	const Image<ColorRgb> & _image;
+	std::vector<ColorRgb> & _ledColors;
+};
+
+HyperionInstances::HyperionInstances(const QJsonObject & qjsonConfig, const QString & configFile)
+	: QObject()
+	, _configs()
+	, _instances()
+	, _grabberComponents()
+	, _mappingPool()
+	, _log(Logger::getInstance("Core"))
+{
+	const QStringList instanceSections = QStringList() << "device" << "leds" << "color" << "smoothing" << "blackborderdetector";
+
+	for (const QJsonValue & value : qjsonConfig["instances"].toArray())
+	{
+		const QJsonObject instanceConfig = value.toObject();
+		const QString name = instanceConfig["name"].toString();
+
+		QJsonObject config = qjsonConfig;
+		config.remove("instances");
+		// the main instance forwards the messages
+		config["forwarder"] = QJsonObject();
+		for (const QString & section : instanceSections)
+		{
+			if (instanceConfig.contains(section))
+			{
+				config[section] = instanceConfig[section];
+			}
+		}
+		_configs.push_back(config);
+
+		// the active device reported to the clients (and edited by the web ui) is the device of the main instance
+		const std::string activeDevice = LedDevice::activeDevice();
+		Instance instance;
+		instance.hyperion  = Hyperion::createInstance(name, _configs.back(), configFile);
+		LedDevice::setActiveDevice(activeDevice);
+		instance.processor = ImageProcessorFactory::getInstance().newImageProcessor(
+			instance.hyperion->getLedString(),
+			_configs.back()["blackborderdetector"].toObject(),
+			instance.hyperion->getLedMappingType());
+		instance.ledColors.resize(instance.hyperion->getLedCount(), ColorRgb::BLACK);
+		_instances.push_back(instance);
+
+		Info(_log, "Instance '%s' with %u leds created", name.toLocal8Bit().constData(), instance.hyperion->getLedCount());
+	}
+
+	// the calling thread maps the images of the first instance
+	_mappingPool.setMaxThreadCount(std::max(1, int(_instances.size()) - 1));
+}
+
+HyperionInstances::~HyperionInstances()
+{
+	_mappingPool.waitForDone();
+
+	for (Instance & instance : _instances)
+	{
+		delete instance.processor;
+		delete instance.hyperion;
+	}
+	_instances.clear();
+}
+
+QSize HyperionInstances::getLedImageSize() const
+{
+	QSize size(1, 1);
+	for (const Instance & instance : _instances)
+	{
+		size = size.expandedTo(instance.hyperion->getLedImageSize());
+	}
+	return size;
+}
+
+void HyperionInstances::addGrabber(QObject * grabber, const hyperion::Components component)
+{
+	if (_instances.empty() || grabber == nullptr)
+	{
+		return;
+	}
+
+	_grabberComponents[grabber] = component;
+	connect(grabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), this, SLOT(setImage(int, const Image<ColorRgb>&, const int)));
+
+	// the grabber is only suspended if it is hidden on the instances as well
+	GrabberWrapper * wrapper = qobject_cast<GrabberWrapper*>(grabber);
+	if (wrapper != nullptr)
+	{
+		for (Instance & instance : _instances)
+		{
+			wrapper->trackVisiblePriority(instance.hyperion);
+		}
+	}
+}
+
+void HyperionInstances::setImage(int priority, const Image<ColorRgb> & image, const int timeout_ms)
+{
+	if (_instances.empty())
+	{
+		return;
+	}
+
+	for (unsigned i = 1; i < _instances.size(); ++i)
+	{
+		_mappingPool.start(new InstanceMappingTask(_instances[i].processor, image, _instances[i].ledColors));
+	}
+	_instances[0].processor->process(image, _instances[0].ledColors);
+
+	// the image is owned by the grabber, wait for the mapping before it is grabbed again
+	_mappingPool.waitForDone();
+
+	const hyperion::Components component = _grabberComponents.value(sender(), hyperion::COMP_GRABBER);
+	for (Instance & instance : _instances)
+	{
+		instance.hyperion->setColors(priority, instance.ledColors, timeout_ms, true, component);
+	}
+}
@@ -14,7 +14,10 @@ ImageProcessor::ImageProcessor(const LedString& ledString, const QJsonObject & b
 	, _log(Logger::getInstance("BLACKBORDER"))
 	, _ledString(ledString)
 	, _borderProcessor(new BlackBorderProcessor(blackborderConfig) )
-	, _imageToLeds(nullptr)
+	, _mapCache(ledString.leds())
+	, _imageToLeds()
+	, _wantedHorizontalBorder(0)
+	, _wantedVerticalBorder(0)
 	, _mappingType(0)
 {
 // this is when we want to change the mapping for all input sources
@@ -23,7 +26,6 @@ ImageProcessor::ImageProcessor(const LedString& ledString, const QJsonObject & b
 
 ImageProcessor::~ImageProcessor()
 {
-	delete _imageToLeds;
 	delete _borderProcessor;
 }
 
@@ -40,11 +42,30 @@ void ImageProcessor::setSize(const unsigned width, const unsigned height)
 		return;
 	}
 
-	// Clean up the old buffer and mapping
-	delete _imageToLeds;
+	// The old mapping does not fit the new size, build the new one right away
+	_wantedHorizontalBorder = 0;
+	_wantedVerticalBorder   = 0;
+	_imageToLeds = _mapCache.get(width, height, 0, 0);
+}
 
-	// Construct a new buffer and mapping
-	_imageToLeds = new ImageToLedsMap(width, height, 0, 0, _ledString.leds());
+void ImageProcessor::setBorder(const unsigned horizontalBorder, const unsigned verticalBorder)
+{
+	_wantedHorizontalBorder = horizontalBorder;
+	_wantedVerticalBorder   = verticalBorder;
+	updateMapping();
+}
+
+void ImageProcessor::updateMapping()
+{
+	const QSharedPointer<const ImageToLedsMap> map = _mapCache.find(_imageToLeds->width(), _imageToLeds->height(), _wantedHorizontalBorder, _wantedVerticalBorder);
+	if (map)
+	{
+		_imageToLeds = map;
+	}
+	else
+	{
+		_mapCache.request(_imageToLeds->width(), _imageToLeds->height(), _wantedHorizontalBorder, _wantedVerticalBorder);
+	}
 }
 
 void ImageProcessor::enableBlackBorderDetector(bool enable)
@@ -23,3 +23,11 @@ ImageProcessor* ImageProcessorFactory::newImageProcessor() const
 
 	return ip;
 }
+
+ImageProcessor* ImageProcessorFactory::newImageProcessor(const LedString& ledString, const QJsonObject & blackborderConfig, int mappingType) const
+{
+	ImageProcessor* ip = new ImageProcessor(ledString, blackborderConfig);
+	ip->setLedMappingType(mappingType);
+
+	return ip;
+}
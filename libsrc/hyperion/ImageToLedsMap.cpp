@@ -3,11 +3,79 @@
 #include <cmath>
 #include <cassert>
 
+// QT includes
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
+
 // hyperion includes
 #include <hyperion/ImageToLedsMap.h>
 
 using namespace hyperion;
 
+namespace
+{
+	/// chunks per thread, the threads take the next free chunk, so a slow thread takes fewer chunks
+	const unsigned CHUNKS_PER_THREAD = 4;
+
+	///
+	/// The persistent threads of the parallel mapping, shared by all maps
+	///
+	QThreadPool& mappingPool()
+	{
+		static QThreadPool pool;
+		return pool;
+	}
+
+	///
+	/// The chunks of one mapping call. It is shared with the pool tasks, which may start after
+	/// all chunks are already done by the other threads.
+	///
+	struct ChunkRun
+	{
+		std::function<void(unsigned, unsigned)> work;
+		/// only valid while chunks are left, the map waits for them
+		const std::vector<unsigned> * chunkStarts;
+		unsigned chunkCount;
+		unsigned ledCount;
+		QAtomicInt nextChunk;
+		QSemaphore chunksDone;
+
+		/// takes and runs free chunks until none is left
+		void runFreeChunks()
+		{
+			for (unsigned chunk = unsigned(nextChunk.fetchAndAddOrdered(1)); chunk < chunkCount; chunk = unsigned(nextChunk.fetchAndAddOrdered(1)))
+			{
+				const unsigned ledEnd = (chunk+1 < chunkCount) ? (*chunkStarts)[chunk+1] : ledCount;
+				work((*chunkStarts)[chunk], ledEnd);
+				chunksDone.release();
+			}
+		}
+	};
+
+	class ChunkTask : public QRunnable
+	{
+	public:
+		ChunkTask(const QSharedPointer<ChunkRun> & run)
+			: QRunnable()
+			, _run(run)
+		{
+			setAutoDelete(true);
+		}
+
+		virtual void run()
+		{
+			_run->runFreeChunks();
+		}
+
+	private:
+		QSharedPointer<ChunkRun> _run;
+	};
+}
+
 ImageToLedsMap::ImageToLedsMap(
 		const unsigned width,
 		const unsigned height,
@@ -72,6 +140,49 @@ ImageToLedsMap::ImageToLedsMap(
 		// Add the constructed vector to the map
 		_colorsMap.push_back(ledColors);
 	}
+
+	// split the leds into chunks of about the same number of pixels for the parallel mapping
+	unsigned mappedPixels = 0;
+	for (const std::vector<unsigned> & ledColors : _colorsMap)
+	{
+		mappedPixels += ledColors.size();
+	}
+
+	const unsigned threadCount = std::max(1, QThread::idealThreadCount());
+	const unsigned chunkCount  = (mappedPixels >= PARALLEL_MIN_PIXELS && threadCount > 1) ? threadCount * CHUNKS_PER_THREAD : 1;
+	const unsigned chunkPixels = std::max(1u, mappedPixels / chunkCount);
+
+	unsigned pixels = 0;
+	_chunkStarts.push_back(0);
+	for (unsigned led = 0; led < _colorsMap.size(); ++led)
+	{
+		if (pixels >= chunkPixels)
+		{
+			_chunkStarts.push_back(led);
+			pixels = 0;
+		}
+		pixels += _colorsMap[led].size();
+	}
+}
+
+void ImageToLedsMap::runChunks(const std::function<void(unsigned, unsigned)> & work) const
+{
+	QSharedPointer<ChunkRun> run(new ChunkRun());
+	run->work        = work;
+	run->chunkStarts = &_chunkStarts;
+	run->chunkCount  = _chunkStarts.size();
+	run->ledCount    = _colorsMap.size();
+
+	// the calling thread is one of the mapping threads
+	const int helpers = std::min(int(_chunkStarts.size()), QThread::idealThreadCount()) - 1;
+	for (int i = 0; i < helpers; ++i)
+	{
+		mappingPool().start(new ChunkTask(run));
+	}
+	run->runFreeChunks();
+
+	// the helpers may still run chunks taken before the calling thread ran out of chunks
+	run->chunksDone.acquire(_chunkStarts.size());
 }
 
 unsigned ImageToLedsMap::width() const
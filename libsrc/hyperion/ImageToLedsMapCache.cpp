@@ -0,0 +1,161 @@
+// STL includes
+#include <algorithm>
+#include <list>
+
+// QT includes
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+
+// hyperion includes
+#include <hyperion/ImageToLedsMapCache.h>
+
+using namespace hyperion;
+
+namespace
+{
+	/// The image size and borders a mapping is built for
+	struct MapKey
+	{
+		unsigned width;
+		unsigned height;
+		unsigned horizontalBorder;
+		unsigned verticalBorder;
+
+		bool operator==(const MapKey & other) const
+		{
+			return width == other.width && height == other.height
+				&& horizontalBorder == other.horizontalBorder && verticalBorder == other.verticalBorder;
+		}
+	};
+}
+
+struct ImageToLedsMapCache::Data
+{
+	struct Entry
+	{
+		MapKey key;
+		QSharedPointer<const ImageToLedsMap> map;
+	};
+
+	Data(const std::vector<Led> & leds, const unsigned capacity)
+		: leds(leds)
+		, capacity(std::max(1u, capacity))
+	{
+	}
+
+	/// Returns the cached mapping and marks it as most recently used, the caller locks the mutex
+	QSharedPointer<const ImageToLedsMap> find(const MapKey & key)
+	{
+		for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+		{
+			if (entry->key == key)
+			{
+				entries.splice(entries.begin(), entries, entry);
+				return entries.front().map;
+			}
+		}
+		return QSharedPointer<const ImageToLedsMap>();
+	}
+
+	/// Adds the mapping as most recently used and drops the least recently used, the caller locks the mutex
+	void insert(const MapKey & key, const QSharedPointer<const ImageToLedsMap> & map)
+	{
+		entries.push_front(Entry{key, map});
+		while (entries.size() > capacity)
+		{
+			entries.pop_back();
+		}
+	}
+
+	QSharedPointer<const ImageToLedsMap> build(const MapKey & key) const
+	{
+		return QSharedPointer<const ImageToLedsMap>(new ImageToLedsMap(key.width, key.height, key.horizontalBorder, key.verticalBorder, leds));
+	}
+
+	const std::vector<Led> leds;
+	const unsigned capacity;
+
+	QMutex mutex;
+	/// The cached mappings, the most recently used first
+	std::list<Entry> entries;
+	/// The mappings being built in the background
+	std::vector<MapKey> pending;
+};
+
+namespace hyperion
+{
+	///
+	/// Builds a mapping on a thread of the global thread pool and adds it to the cache
+	///
+	class MapBuildTask : public QRunnable
+	{
+	public:
+		MapBuildTask(const QSharedPointer<ImageToLedsMapCache::Data> & data, const MapKey & key)
+			: QRunnable()
+			, _data(data)
+			, _key(key)
+		{
+			setAutoDelete(true);
+		}
+
+		virtual void run()
+		{
+			const QSharedPointer<const ImageToLedsMap> map = _data->build(_key);
+
+			QMutexLocker lock(&_data->mutex);
+			_data->pending.erase(std::remove(_data->pending.begin(), _data->pending.end(), _key), _data->pending.end());
+			_data->insert(_key, map);
+		}
+
+	private:
+		QSharedPointer<ImageToLedsMapCache::Data> _data;
+		const MapKey _key;
+	};
+}
+
+ImageToLedsMapCache::ImageToLedsMapCache(const std::vector<Led> & leds, const unsigned capacity)
+	: _data(new Data(leds, capacity))
+{
+}
+
+QSharedPointer<const ImageToLedsMap> ImageToLedsMapCache::find(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder)
+{
+	QMutexLocker lock(&_data->mutex);
+	return _data->find(MapKey{width, height, horizontalBorder, verticalBorder});
+}
+
+QSharedPointer<const ImageToLedsMap> ImageToLedsMapCache::get(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder)
+{
+	const MapKey key{width, height, horizontalBorder, verticalBorder};
+	{
+		QMutexLocker lock(&_data->mutex);
+		QSharedPointer<const ImageToLedsMap> map = _data->find(key);
+		if (map)
+		{
+			return map;
+		}
+	}
+
+	// a pending background build of the same mapping only adds a second entry, which is dropped first
+	const QSharedPointer<const ImageToLedsMap> map = _data->build(key);
+
+	QMutexLocker lock(&_data->mutex);
+	_data->insert(key, map);
+	return map;
+}
+
+void ImageToLedsMapCache::request(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder)
+{
+	const MapKey key{width, height, horizontalBorder, verticalBorder};
+
+	QMutexLocker lock(&_data->mutex);
+	if (_data->find(key) || std::find(_data->pending.begin(), _data->pending.end(), key) != _data->pending.end())
+	{
+		return;
+	}
+
+	_data->pending.push_back(key);
+	QThreadPool::globalInstance()->start(new MapBuildTask(_data, key));
+}
@@ -3,6 +3,9 @@
 #include <unistd.h>
 #include <iostream>
 
+// QT includes
+#include <QCryptographicHash>
+
 // hyperion includes
 #include <hyperion/LedString.h>
 
@@ -26,3 +29,18 @@ const std::vector<Led>& LedString::leds() const
 {
 	return mLeds;
 }
+
+QByteArray LedString::layoutHash() const
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	for (const Led& led : mLeds)
+	{
+		hash.addData(QString("%1:%2,%3,%4,%5;")
+			.arg(led.index)
+			.arg(led.minX_frac, 0, 'f', 6)
+			.arg(led.maxX_frac, 0, 'f', 6)
+			.arg(led.minY_frac, 0, 'f', 6)
+			.arg(led.maxY_frac, 0, 'f', 6).toUtf8());
+	}
+	return hash.result();
+}
@@ -0,0 +1,51 @@
+// Qt includes
+#include <QDateTime>
+
+// Local Hyperion includes
+#include "DeltaOutput.h"
+
+DeltaOutput::DeltaOutput()
+	: _enabled(false)
+	, _keyframeInterval_ms(1000)
+	, _lastKeyframe(0)
+	, _keyframe(true)
+	, _sentValues()
+{
+}
+
+void DeltaOutput::init(const QJsonObject &deviceConfig)
+{
+	_enabled             = deviceConfig["deltaOutput"].toBool(false);
+	_keyframeInterval_ms = deviceConfig["keyframeInterval"].toInt(_keyframeInterval_ms);
+	reset();
+}
+
+bool DeltaOutput::beginFrame()
+{
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	_keyframe = !_enabled || _lastKeyframe == 0 || now - _lastKeyframe >= _keyframeInterval_ms;
+	if (_keyframe)
+	{
+		_lastKeyframe = now;
+	}
+	return _keyframe;
+}
+
+bool DeltaOutput::isChanged(const unsigned index, const ColorRgb &color)
+{
+	if (index >= _sentValues.size())
+	{
+		_sentValues.resize(index + 1, ColorRgb::BLACK);
+		_keyframe = true;
+	}
+
+	const bool changed = _keyframe || _sentValues[index] != color;
+	_sentValues[index] = color;
+	return changed;
+}
+
+void DeltaOutput::reset()
+{
+	_lastKeyframe = 0;
+	_sentValues.clear();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// STL includes
+#include <vector>
+
+// Qt includes
+#include <QJsonObject>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+
+///
+/// Tracks which leds changed since they were last sent, for network devices that only transmit
+/// changed leds. At the configured keyframe interval every led is reported as changed, so
+/// receivers recover from lost packets.
+///
+class DeltaOutput
+{
+public:
+	DeltaOutput();
+
+	///
+	/// Sets configuration
+	///
+	/// @param deviceConfig the json device config, uses "deltaOutput" and "keyframeInterval"
+	///
+	void init(const QJsonObject &deviceConfig);
+
+	///
+	/// @return true if only changed leds should be sent
+	///
+	bool isEnabled() const { return _enabled; }
+
+	///
+	/// Starts a new frame, must be called once before the leds of the frame are checked
+	///
+	/// @return true if this frame is a keyframe and all leds must be sent
+	///
+	bool beginFrame();
+
+	///
+	/// Checks a led of the current frame and remembers its color as sent
+	///
+	/// @param index The index of the led
+	/// @param color The color of the led in this frame
+	///
+	/// @return true if the led must be sent
+	///
+	bool isChanged(const unsigned index, const ColorRgb &color);
+
+	///
+	/// Makes the next frame a keyframe, e.g. after the device was switched off
+	///
+	void reset();
+
+private:
+	/// Only send changed leds
+	bool _enabled;
+
+	/// Time between two keyframes in ms
+	int _keyframeInterval_ms;
+
+	/// Time of the last keyframe in ms since epoch
+	qint64 _lastKeyframe;
+
+	/// true while a keyframe is checked
+	bool _keyframe;
+
+	/// The colors last sent per led
+	std::vector<ColorRgb> _sentValues;
+};
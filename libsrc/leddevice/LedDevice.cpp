@@ -8,20 +8,19 @@
 
 LedDeviceRegistry LedDevice::_ledDeviceMap = LedDeviceRegistry();
 std::string LedDevice::_activeDevice = "";
-int LedDevice::_ledCount    = 0;
-int LedDevice::_ledRGBCount = 0;
-int LedDevice::_ledRGBWCount= 0;
+int LedDevice::_nextLedCount = 0;
 
 LedDevice::LedDevice()
 	: QObject()
 	, _log(Logger::getInstance("LedDevice"))
 	, _ledBuffer(0)
 	, _deviceReady(true)
+	, _ledCount(_nextLedCount)
+	, _ledRGBCount(_nextLedCount * sizeof(ColorRgb))
+	, _ledRGBWCount(_nextLedCount * sizeof(ColorRgbw))
 	, _refresh_timer()
 	, _refresh_timer_interval(0)
 {
-	LedDevice::getLedDeviceSchemas();
-
 	// setup timer
 	_refresh_timer.setSingleShot(false);
 	_refresh_timer.setInterval(0);
@@ -58,6 +57,13 @@ bool LedDevice::init(const QJsonObject &deviceConfig)
 
 QJsonObject LedDevice::getLedDeviceSchemas()
 {
+	// the schemas are compiled in and never change, parse them only once
+	static QJsonObject ledDeviceSchemas;
+	if (!ledDeviceSchemas.isEmpty())
+	{
+		return ledDeviceSchemas;
+	}
+
 	// make sure the resources are loaded (they may be left out after static linking)
 	Q_INIT_RESOURCE(LedDeviceSchemas);
 	QJsonParseError error;
@@ -109,6 +115,7 @@ QJsonObject LedDevice::getLedDeviceSchemas()
 		result[devName] = schemaJson;
 	}
 	
+	ledDeviceSchemas = result;
 	return result;
 }
 
@@ -136,9 +143,7 @@ int LedDevice::switchOff()
 
 void LedDevice::setLedCount(int ledCount)
 {
-	_ledCount     = ledCount;
-	_ledRGBCount  = _ledCount * sizeof(ColorRgb);
-	_ledRGBWCount = _ledCount * sizeof(ColorRgbw);
+	_nextLedCount = ledCount;
 }
 
 int LedDevice::rewriteLeds()
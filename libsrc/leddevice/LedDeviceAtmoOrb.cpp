@@ -37,6 +37,7 @@ bool LedDeviceAtmoOrb::init(const QJsonObject &deviceConfig)
 	_skipSmoothingDiff  = deviceConfig["skipSmoothingDiff"].toInt(0);
 	_multiCastGroupPort = deviceConfig["port"].toInt(49692);
 	_numLeds            = deviceConfig["numLeds"].toInt(24);
+	_deltaOutput.init(deviceConfig);
 	
 	const std::string orbId = deviceConfig["orbIds"].toString().toStdString();
 	_orbIds.clear();
@@ -88,12 +89,21 @@ int LedDeviceAtmoOrb::write(const std::vector <ColorRgb> &ledValues)
 		commandType = 2;
 	}
 
+	_deltaOutput.beginFrame();
+
 	// Iterate through colors and set Orb color
 	// Start off with idx 1 as 0 is reserved for controlling all orbs at once
 	unsigned int idx = 1;
 
 	for (const ColorRgb &color : ledValues)
 	{
+		// Skip orbs which didn't change since the last keyframe
+		if (!_deltaOutput.isChanged(idx - 1, color))
+		{
+			idx++;
+			continue;
+		}
+
 		// Retrieve last send colors
 		int lastRed = lastColorRedMap[idx];
 		int lastGreen = lastColorGreenMap[idx];
@@ -169,6 +179,7 @@ void LedDeviceAtmoOrb::sendCommand(const QByteArray &bytes)
 
 int LedDeviceAtmoOrb::switchOff()
 {
+	_deltaOutput.reset();
 	for (auto orbId : _orbIds)
 	{
 		setColor(orbId, ColorRgb::BLACK, 1);
@@ -8,6 +8,7 @@
 
 // Leddevice includes
 #include <leddevice/LedDevice.h>
+#include "DeltaOutput.h"
 
 class QUdpSocket;
 
@@ -103,6 +104,9 @@ private:
 	/// Array of the orb ids.
 	std::vector<unsigned int> _orbIds;
 
+	/// Sends only changed orbs if enabled
+	DeltaOutput _deltaOutput;
+
 	///
 	/// Set Orbcolor
 	///
@@ -48,6 +48,7 @@
 #include "LedDeviceAtmo.h"
 #include "LedDeviceAtmoOrb.h"
 #include "LedDeviceUdpH801.h"
+#include "LedDeviceGroup.h"
 
 #ifdef ENABLE_WS281XPWM
 	#include "LedDeviceWS281x.h"
@@ -113,6 +114,7 @@ LedDevice * LedDeviceFactory::construct(const QJsonObject & deviceConfig, const
 	// other
 	REGISTER(File);
 	REGISTER(PiBlaster);
+	REGISTER(Group);
 	
 	#undef REGISTER
 
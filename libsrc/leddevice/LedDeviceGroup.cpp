@@ -0,0 +1,153 @@
+// Qt includes
+#include <QDateTime>
+
+// Leddevice includes
+#include <leddevice/LedDeviceFactory.h>
+
+// Local Hyperion includes
+#include "LedDeviceGroup.h"
+
+LedDeviceGroup::LedDeviceGroup(const QJsonObject &deviceConfig)
+	: LedDevice()
+	, _members()
+	, _pendingTimer()
+{
+	_pendingTimer.setSingleShot(true);
+	connect(&_pendingTimer, SIGNAL(timeout()), this, SLOT(writeDueMembers()));
+
+	_deviceReady = init(deviceConfig);
+}
+
+LedDeviceGroup::~LedDeviceGroup()
+{
+	clearMembers();
+}
+
+LedDevice* LedDeviceGroup::construct(const QJsonObject &deviceConfig)
+{
+	return new LedDeviceGroup(deviceConfig);
+}
+
+bool LedDeviceGroup::init(const QJsonObject &deviceConfig)
+{
+	LedDevice::init(deviceConfig);
+
+	clearMembers();
+
+	unsigned ledStart = 0;
+	for (const QJsonValue & value : deviceConfig["members"].toArray())
+	{
+		const QJsonObject memberConfig = value.toObject();
+		const QString type = memberConfig["type"].toString().toLower();
+		if (type == "group")
+		{
+			Error(_log, "A device group can't contain another group");
+			continue;
+		}
+
+		const unsigned remaining = unsigned(_ledCount) - std::min(ledStart, unsigned(_ledCount));
+		const unsigned ledCount  = std::min(unsigned(memberConfig["leds"].toInt(remaining)), remaining);
+		const int maxRate        = memberConfig["maxRate"].toInt(0);
+
+		Member member;
+		member.device         = LedDeviceFactory::construct(memberConfig, ledCount);
+		member.type           = type;
+		member.ledStart       = ledStart;
+		member.ledCount       = ledCount;
+		member.minInterval_ms = (maxRate > 0) ? 1000 / maxRate : 0;
+		member.lastWrite      = 0;
+		member.pending        = false;
+		member.failed         = false;
+		_members.push_back(member);
+
+		Info(_log, "Device group: %s drives %u leds starting at led %u", type.toLocal8Bit().constData(), ledCount, ledStart);
+		ledStart += ledCount;
+	}
+
+	// the factory sets the led count of the next constructed device for every member, restore it for
+	// the devices constructed after the group (e.g. the smoothing)
+	LedDevice::setLedCount(_ledCount);
+
+	WarningIf((int(ledStart) < _ledCount), _log, "Device group: %d leds are not assigned to a member", _ledCount - int(ledStart));
+
+	return !_members.empty();
+}
+
+void LedDeviceGroup::clearMembers()
+{
+	_pendingTimer.stop();
+	for (Member & member : _members)
+	{
+		delete member.device;
+	}
+	_members.clear();
+}
+
+int LedDeviceGroup::write(const std::vector<ColorRgb> & ledValues)
+{
+	for (Member & member : _members)
+	{
+		const unsigned ledStart = std::min(member.ledStart, unsigned(ledValues.size()));
+		const unsigned ledEnd   = std::min(member.ledStart + member.ledCount, unsigned(ledValues.size()));
+		member.ledValues.assign(ledValues.begin() + ledStart, ledValues.begin() + ledEnd);
+		member.ledValues.resize(member.ledCount, ColorRgb::BLACK);
+		member.pending = true;
+	}
+
+	writeDueMembers();
+	return 0;
+}
+
+void LedDeviceGroup::writeDueMembers()
+{
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	qint64 nextDue = 0;
+
+	for (Member & member : _members)
+	{
+		if (!member.pending)
+		{
+			continue;
+		}
+
+		const qint64 due = member.lastWrite + member.minInterval_ms;
+		if (due > now)
+		{
+			nextDue = (nextDue == 0) ? due : std::min(nextDue, due);
+			continue;
+		}
+
+		member.pending   = false;
+		member.lastWrite = now;
+
+		const bool failed = member.device->setLedValues(member.ledValues) < 0;
+		if (failed != member.failed)
+		{
+			WarningIf(failed, _log, "Device group: writing to %s failed", member.type.toLocal8Bit().constData());
+			InfoIf(!failed, _log, "Device group: writing to %s works again", member.type.toLocal8Bit().constData());
+			member.failed = failed;
+		}
+	}
+
+	// write the newest leds of the rate limited members when they are due
+	if (nextDue > 0)
+	{
+		_pendingTimer.start(int(nextDue - now));
+	}
+}
+
+int LedDeviceGroup::switchOff()
+{
+	_pendingTimer.stop();
+
+	int retVal = 0;
+	for (Member & member : _members)
+	{
+		member.pending = false;
+		if (member.device->switchOff() < 0)
+		{
+			retVal = -1;
+		}
+	}
+	return retVal;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Qt includes
+#include <QTimer>
+
+// Leddevice includes
+#include <leddevice/LedDevice.h>
+
+///
+/// Implementation of the LedDevice interface that slices the leds into consecutive ranges and
+/// forwards every range to its own member LedDevice. This way one capture and mapping pass can
+/// feed several devices, e.g. a SPI strip, E1.31 fixtures and Hue bulbs.
+///
+/// Every member is configured like a normal device plus:
+/// - "leds": the number of leds of the member (default: all remaining leds)
+/// - "maxRate": the maximum update rate of the member in Hz (0 = unlimited)
+///
+/// A member that fails to write doesn't affect the other members.
+///
+class LedDeviceGroup : public LedDevice
+{
+	Q_OBJECT
+
+public:
+	///
+	/// Constructs specific LedDevice
+	///
+	/// @param deviceConfig json device config
+	///
+	LedDeviceGroup(const QJsonObject &deviceConfig);
+
+	///
+	/// Destructor of this device, deletes the members
+	///
+	virtual ~LedDeviceGroup();
+
+	/// constructs leddevice
+	static LedDevice* construct(const QJsonObject &deviceConfig);
+
+	///
+	/// Sets configuration and constructs the members
+	///
+	/// @param deviceConfig the json device config
+	/// @return true if success
+	virtual bool init(const QJsonObject &deviceConfig);
+
+	/// Switch the leds of all members off
+	virtual int switchOff();
+
+private slots:
+	/// Writes the pending leds of every member whose rate limit allows it
+	void writeDueMembers();
+
+private:
+	///
+	/// Stores the leds of every member and writes the members that are due
+	///
+	/// @param ledValues The color-value per led
+	/// @return Zero on success else negative
+	///
+	virtual int write(const std::vector<ColorRgb> & ledValues);
+
+	/// A device driving a range of the leds
+	struct Member
+	{
+		/// The device, owned by the group
+		LedDevice * device;
+		/// The type of the device
+		QString type;
+		/// The index of the first led of the member
+		unsigned ledStart;
+		/// The number of leds of the member
+		unsigned ledCount;
+		/// Minimum time between two writes in ms
+		int minInterval_ms;
+		/// Time of the last write in ms since epoch
+		qint64 lastWrite;
+		/// The leds waiting to be written
+		std::vector<ColorRgb> ledValues;
+		/// true if ledValues are not written yet
+		bool pending;
+		/// true if the last write failed
+		bool failed;
+	};
+
+	/// Deletes all members
+	void clearMembers();
+
+	/// The member devices
+	std::vector<Member> _members;
+
+	/// Fires when the next rate limited member is due
+	QTimer _pendingTimer;
+};
@@ -5,11 +5,21 @@
 #include <QtCore/qmath.h>
 #include <QEventLoop>
 #include <QNetworkReply>
+#include <QDateTime>
 
 #include <stdexcept>
 #include <set>
 #include <cmath>
 
+/// Smallest xy distance that is sent to a light, about the size of a just noticeable difference
+static const float XY_CHANGE_THRESHOLD = 0.004f;
+/// Smallest brightness change that is sent to a light (2 of 255 steps)
+static const float BRI_CHANGE_THRESHOLD = 2.0f / 255.0f;
+/// Requests the bridge didn't answer yet, more would only queue up in the bridge
+static const int MAX_REQUESTS_IN_FLIGHT = 2;
+/// The bridge handles about one group request per second
+static const qint64 GROUP_REQUEST_INTERVAL_MS = 1000;
+
 bool operator ==(CiColor p1, CiColor p2) {
 	return (p1.x == p2.x) && (p1.y == p2.y) && (p1.bri == p2.bri);
 }
@@ -59,6 +69,7 @@ PhilipsHueLight::PhilipsHueLight(unsigned int id, QString originalState, QString
 	black = rgbToCiColor(0.0f, 0.0f, 0.0f);
 	// Initialize color with black
 	color = {black.x, black.y, black.bri};
+	target = color;
 }
 
 float PhilipsHueLight::crossProduct(CiColor p1, CiColor p2)
@@ -98,7 +109,7 @@ CiColor PhilipsHueLight::getClosestPointToPoint(CiColor a, CiColor b, CiColor p)
 	return {a.x + AB.x * t, a.y + AB.y * t};
 }
 
-float PhilipsHueLight::getDistanceBetweenTwoPoints(CiColor p1, CiColor p2)
+float PhilipsHueLight::getDistanceBetweenTwoPoints(CiColor p1, CiColor p2) const
 {
 	// Horizontal difference.
 	float dx = p1.x - p2.x;
@@ -163,6 +174,10 @@ CiColor PhilipsHueLight::rgbToCiColor(float red, float green, float blue)
 
 LedDevicePhilipsHue::LedDevicePhilipsHue(const QJsonObject &deviceConfig)
 	: LedDevice()
+	, requestsInFlight(0)
+	, nextLight(0)
+	, groupId(-1)
+	, lastGroupRequest(0)
 {
 	_deviceReady = init(deviceConfig);
 
@@ -170,6 +185,7 @@ LedDevicePhilipsHue::LedDevicePhilipsHue(const QJsonObject &deviceConfig)
 	timer.setInterval(3000);
 	timer.setSingleShot(true);
 	connect(&timer, SIGNAL(timeout()), this, SLOT(restoreStates()));
+	connect(&sendTimer, SIGNAL(timeout()), this, SLOT(sendNextChange()));
 }
 
 LedDevicePhilipsHue::~LedDevicePhilipsHue()
@@ -185,6 +201,8 @@ bool LedDevicePhilipsHue::init(const QJsonObject &deviceConfig)
 	username = deviceConfig["username"].toString("newdeveloper").toStdString().c_str();
 	switchOffOnBlack = deviceConfig["switchOffOnBlack"].toBool(true);
 	transitiontime = deviceConfig["transitiontime"].toInt(1);
+	groupId = deviceConfig["groupId"].toInt(-1);
+	sendTimer.setInterval(1000 / qMax(1, deviceConfig["requestRate"].toInt(10)));
 	lightIds.clear();
 	QJsonArray lArray = deviceConfig["lightIds"].toArray();
 	for(int i = 0; i < lArray.size(); i++)
@@ -214,54 +232,142 @@ int LedDevicePhilipsHue::write(const std::vector<ColorRgb> & ledValues)
 		restoreStates();
 		return 0;
 	}
-	// Iterate through colors and set light states.
+	// Iterate through colors and update the target of each light.
 	unsigned int idx = 0;
 	for (const ColorRgb& color : ledValues)
 	{
 		// Get lamp.
 		PhilipsHueLight& lamp = lights.at(idx);
 		// Scale colors from [0, 255] to [0, 1] and convert to xy space.
-		CiColor xy = lamp.rgbToCiColor(color.red / 255.0f, color.green / 255.0f, color.blue / 255.0f);
-		// Write color if color has been changed.
-		if (xy != lamp.color)
-		{
-			// From a color to black.
-			if (switchOffOnBlack && lamp.color != lamp.black && xy == lamp.black)
-			{
-				put(getStateRoute(lamp.id), QString("{\"on\": false}"));
-			}
-			// From black to a color
-			else if (switchOffOnBlack && lamp.color == lamp.black && xy != lamp.black)
-			{
-				// Send adjust color and brightness command in JSON format.
-				// We have to set the transition time each time.
-				// Send also command to switch the lamp on.
-				put(getStateRoute(lamp.id),
-						QString("{\"on\": true, \"xy\": [%1, %2], \"bri\": %3, \"transitiontime\": %4}").arg(xy.x).arg(
-								xy.y).arg(qRound(xy.bri * 255.0f)).arg(transitiontime));
-			}
-			// Normal color change.
-			else
-			{
-				// Send adjust color and brightness command in JSON format.
-				// We have to set the transition time each time.
-				put(getStateRoute(lamp.id),
-						QString("{\"xy\": [%1, %2], \"bri\": %3, \"transitiontime\": %4}").arg(xy.x).arg(xy.y).arg(
-								qRound(xy.bri * 255.0f)).arg(transitiontime));
-			}
-		}
-		// Remember last color.
-		lamp.color = xy;
+		lamp.target = lamp.rgbToCiColor(color.red / 255.0f, color.green / 255.0f, color.blue / 255.0f);
 		// Next light id.
 		idx++;
 	}
+	// The send timer runs as long as there are changes to send.
+	if (!sendTimer.isActive())
+	{
+		sendNextChange();
+	}
 	timer.start();
 	return 0;
 }
 
+bool LedDevicePhilipsHue::isNoticeableChange(const PhilipsHueLight& lamp, CiColor xy)
+{
+	// Switching on or off is always sent.
+	if (switchOffOnBlack && ((lamp.color == lamp.black) != (xy == lamp.black)))
+	{
+		return true;
+	}
+	return lamp.getDistanceBetweenTwoPoints(lamp.color, xy) >= XY_CHANGE_THRESHOLD
+		|| std::fabs(lamp.color.bri - xy.bri) >= BRI_CHANGE_THRESHOLD;
+}
+
+QString LedDevicePhilipsHue::getStateContent(const PhilipsHueLight& lamp, CiColor xy)
+{
+	// From a color to black.
+	if (switchOffOnBlack && lamp.color != lamp.black && xy == lamp.black)
+	{
+		return QString("{\"on\": false}");
+	}
+	// From black to a color
+	if (switchOffOnBlack && lamp.color == lamp.black && xy != lamp.black)
+	{
+		// Send adjust color and brightness command in JSON format.
+		// We have to set the transition time each time.
+		// Send also command to switch the lamp on.
+		return QString("{\"on\": true, \"xy\": [%1, %2], \"bri\": %3, \"transitiontime\": %4}").arg(xy.x).arg(
+				xy.y).arg(qRound(xy.bri * 255.0f)).arg(transitiontime);
+	}
+	// Normal color change.
+	// Send adjust color and brightness command in JSON format.
+	// We have to set the transition time each time.
+	return QString("{\"xy\": [%1, %2], \"bri\": %3, \"transitiontime\": %4}").arg(xy.x).arg(xy.y).arg(
+			qRound(xy.bri * 255.0f)).arg(transitiontime);
+}
+
+void LedDevicePhilipsHue::sendNextChange()
+{
+	// Wait for the bridge to catch up, the timer retries (it may be stopped if write() called us).
+	if (requestsInFlight >= MAX_REQUESTS_IN_FLIGHT)
+	{
+		sendTimer.start();
+		return;
+	}
+
+	if (groupId >= 0 && sendGroupChange())
+	{
+		sendTimer.start();
+		return;
+	}
+
+	// Send the first noticeable change after the light sent last, so every light gets its turn.
+	for (unsigned int i = 0; i < lights.size(); i++)
+	{
+		PhilipsHueLight& lamp = lights.at((nextLight + i) % lights.size());
+		if (isNoticeableChange(lamp, lamp.target))
+		{
+			sendState(getStateRoute(lamp.id), getStateContent(lamp, lamp.target));
+			// Remember last color.
+			lamp.color = lamp.target;
+			nextLight = (nextLight + i + 1) % lights.size();
+			sendTimer.start();
+			return;
+		}
+	}
+
+	// Nothing left to send.
+	sendTimer.stop();
+}
+
+bool LedDevicePhilipsHue::sendGroupChange()
+{
+	if (lights.size() < 2 || QDateTime::currentMSecsSinceEpoch() - lastGroupRequest < GROUP_REQUEST_INTERVAL_MS)
+	{
+		return false;
+	}
+
+	// All lights must show the same color and at least one of them must change.
+	const PhilipsHueLight& first = lights.front();
+	bool changed = false;
+	for (const PhilipsHueLight& lamp : lights)
+	{
+		if (first.getDistanceBetweenTwoPoints(first.target, lamp.target) >= XY_CHANGE_THRESHOLD
+			|| std::fabs(first.target.bri - lamp.target.bri) >= BRI_CHANGE_THRESHOLD)
+		{
+			return false;
+		}
+		changed |= isNoticeableChange(lamp, lamp.target);
+	}
+	if (!changed)
+	{
+		return false;
+	}
+
+	// The lights may be on or off, so the group action always sets the on state.
+	const CiColor xy = first.target;
+	if (switchOffOnBlack && xy == first.black)
+	{
+		sendState(QString("groups/%1/action").arg(groupId), QString("{\"on\": false}"));
+	}
+	else
+	{
+		sendState(QString("groups/%1/action").arg(groupId),
+				QString("{\"on\": true, \"xy\": [%1, %2], \"bri\": %3, \"transitiontime\": %4}").arg(xy.x).arg(
+						xy.y).arg(qRound(xy.bri * 255.0f)).arg(transitiontime));
+	}
+	for (PhilipsHueLight& lamp : lights)
+	{
+		lamp.color = lamp.target;
+	}
+	lastGroupRequest = QDateTime::currentMSecsSinceEpoch();
+	return true;
+}
+
 int LedDevicePhilipsHue::switchOff()
 {
 	timer.stop();
+	sendTimer.stop();
 	// If light states have been saved before, ...
 	if (areStatesSaved())
 	{
@@ -286,6 +392,20 @@ void LedDevicePhilipsHue::put(QString route, QString content)
 	reply->deleteLater();
 }
 
+void LedDevicePhilipsHue::sendState(QString route, QString content)
+{
+	QNetworkRequest request(getUrl(route));
+	QNetworkReply* reply = manager->put(request, content.toLatin1());
+	connect(reply, SIGNAL(finished()), this, SLOT(stateSent()));
+	requestsInFlight++;
+}
+
+void LedDevicePhilipsHue::stateSent()
+{
+	requestsInFlight--;
+	sender()->deleteLater();
+}
+
 QByteArray LedDevicePhilipsHue::get(QString route)
 {
 	QString url = getUrl(route);
@@ -415,6 +535,7 @@ void LedDevicePhilipsHue::switchOn(unsigned int nLights)
 
 void LedDevicePhilipsHue::restoreStates()
 {
+	sendTimer.stop();
 	for (PhilipsHueLight light : lights)
 	{
 		put(getStateRoute(light.id), light.originalState);
@@ -36,7 +36,10 @@ class PhilipsHueLight {
 public:
 	unsigned int id;
 	CiColor black;
+	/// The color last sent to the light
 	CiColor color;
+	/// The color the light should show, sent when it differs noticeably from color
+	CiColor target;
 	CiColorTriangle colorSpace;
 	QString originalState;
 
@@ -92,7 +95,7 @@ public:
 	///
 	/// @return the distance between the two points
 	///
-	float getDistanceBetweenTwoPoints(CiColor p1, CiColor p2);
+	float getDistanceBetweenTwoPoints(CiColor p1, CiColor p2) const;
 };
 
 /**
@@ -100,7 +103,9 @@ public:
  *
  * To use set the device to "philipshue".
  * Uses the official Philips Hue API (http://developers.meethue.com).
- * Framegrabber must be limited to 10 Hz / numer of lights to avoid rate limitation by the hue bridge.
+ * The bridge handles about 10 light requests per second, so the lights are updated round-robin
+ * within that budget and changes below the perceptual thresholds are not sent at all.
+ * If a group is configured, frames where all lights show the same color are sent as one group action.
  * Create a new API user name "newdeveloper" on the bridge (http://developers.meethue.com/gettingstarted.html)
  *
  * @author ntim (github), bimsarck (github)
@@ -139,6 +144,12 @@ private slots:
 	/// Restores the status of all lights.
 	void restoreStates();
 
+	/// Sends the next pending light change, stops the send timer if there is none.
+	void sendNextChange();
+
+	/// Frees a finished state request.
+	void stateSent();
+
 private:
 	///
 	/// Sends the given led-color values via put request to the hue system
@@ -166,6 +177,48 @@ private:
 	int transitiontime;
 	/// Array of the light ids.
 	std::vector<unsigned int> lightIds;
+	/// Paces the state requests to the request budget of the bridge.
+	QTimer sendTimer;
+	/// Number of state requests the bridge didn't answer yet.
+	int requestsInFlight;
+	/// Index of the light to check first for the next request (round-robin).
+	unsigned int nextLight;
+	/// Id of the group used for uniform colors, -1 to disable.
+	int groupId;
+	/// Time of the last group request in ms since epoch.
+	qint64 lastGroupRequest;
+
+	///
+	/// @param lamp the light
+	/// @param xy the new color
+	///
+	/// @return true if the new color is noticeably different from the color last sent to the light.
+	///
+	bool isNoticeableChange(const PhilipsHueLight& lamp, CiColor xy);
+
+	///
+	/// Sends the pending change as one group action if all lights have the same target color.
+	///
+	/// @return true if a group request was sent
+	///
+	bool sendGroupChange();
+
+	///
+	/// @param lamp the light
+	/// @param xy the new color
+	///
+	/// @return the JSON state for changing the light from its last sent color to xy
+	///
+	QString getStateContent(const PhilipsHueLight& lamp, CiColor xy);
+
+	///
+	/// Sends a HTTP PUT request without waiting for the response.
+	///
+	/// @param route the URI of the request
+	///
+	/// @param content content of the request
+	///
+	void sendState(QString route, QString content);
 
 	///
 	/// Sends a HTTP GET request (blocking).
@@ -177,7 +230,7 @@ private:
 	QByteArray get(QString route);
 
 	///
-	/// Sends a HTTP PUT request (non-blocking).
+	/// Sends a HTTP PUT request (blocking).
 	///
 	/// @param route the URI of the request
 	///
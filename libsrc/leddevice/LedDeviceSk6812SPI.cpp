@@ -1,16 +1,17 @@
 #include "LedDeviceSk6812SPI.h"
 
+/*
+T0H 0.3µs, T1H 0.6µs (±150ns) and a bit period of 1.25µs (±600ns) give the usable rates:
+4 bits (1000/1100): 2050000 -> 4000000
+3 bits (100/110):   2700000 -> 4400000
+*/
+
 LedDeviceSk6812SPI::LedDeviceSk6812SPI(const QJsonObject &deviceConfig)
 	: ProviderSpi()
 	, _whiteAlgorithm(RGBW::INVALID)
-	, SPI_BYTES_PER_COLOUR(4)
-	, bitpair_to_byte {
-		0b10001000,
-		0b10001100,
-		0b11001000,
-		0b11001100,
-	}
+	, _encoder(4, 0b1000, 0b1100)
 {
+	_multiOutputSupported = true;
 	_deviceReady = init(deviceConfig);
 }
 
@@ -31,45 +32,56 @@ bool LedDeviceSk6812SPI::init(const QJsonObject &deviceConfig)
 	}
 	Debug( _log, "whiteAlgorithm : %s", whiteAlgorithm.c_str());
 
+	const int bitsPerSymbol = deviceConfig["bitsPerSymbol"].toInt(4);
+	if (bitsPerSymbol == 3)
+	{
+		_encoder = SpiClocklessEncoder(3, 0b100, 0b110);
+	}
+	else if (bitsPerSymbol == 4)
+	{
+		_encoder = SpiClocklessEncoder(4, 0b1000, 0b1100);
+	}
+	else
+	{
+		Error(_log, "unsupported bitsPerSymbol %d (3 or 4)", bitsPerSymbol);
+		return false;
+	}
+
 	_baudRate_Hz = 3000000;
 	if ( !ProviderSpi::init(deviceConfig) )
 	{
 		return false;
 	}
-	WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
+	if (bitsPerSymbol == 3)
+	{
+		WarningIf(( _baudRate_Hz < 2700000 || _baudRate_Hz > 4400000 ), _log, "SPI rate %d outside recommended range (2700000 -> 4400000)", _baudRate_Hz);
+	}
+	else
+	{
+		WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
+	}
 
 	const int SPI_FRAME_END_LATCH_BYTES = 3;
-	_ledBuffer.resize(_ledRGBWCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, 0x00);
+	for (SpiOutput& output : _outputs)
+	{
+		output.buffer.resize(output.ledCount * sizeof(ColorRgbw) * _encoder.bytesPerColorByte() + SPI_FRAME_END_LATCH_BYTES, 0x00);
+	}
 	
 	return true;
 }
 
 int LedDeviceSk6812SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgbw) * SPI_BYTES_PER_COLOUR;
+	RGBW::Rgb_to_Rgbw(ledValues, _rgbwValues, _whiteAlgorithm);
 
-
-	for (const ColorRgb& color : ledValues)
+	for (SpiOutput& output : _outputs)
 	{
-		RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-		uint32_t colorBits = 
-			((uint32_t)_temp_rgbw.red << 24) +
-			((uint32_t)_temp_rgbw.green << 16) +
-			((uint32_t)_temp_rgbw.blue << 8) +
-			_temp_rgbw.white;
+		const uint8_t * spi_end = output.buffer.data() + output.buffer.size();
+		uint8_t * spi_ptr = _encoder.encode((const uint8_t *) (_rgbwValues.data() + output.ledStart), output.ledCount * sizeof(ColorRgbw), output.buffer.data());
 
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
-		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
-		}
-		spi_ptr += SPI_BYTES_PER_LED;
+		// latch
+		memset(spi_ptr, 0, spi_end - spi_ptr);
 	}
 
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
-
-	return writeBytes(_ledBuffer.size(), _ledBuffer.data());
+	return writeOutputs();
 }
@@ -2,6 +2,7 @@
 
 // hyperion incluse
 #include "ProviderSpi.h"
+#include "SpiClocklessEncoder.h"
 
 ///
 /// Implementation of the LedDevice interface for writing to Sk6801 led device via SPI.
@@ -37,9 +38,9 @@ private:
 
 	RGBW::WhiteAlgorithm _whiteAlgorithm;
 	
-        const int SPI_BYTES_PER_COLOUR;
-
-	uint8_t bitpair_to_byte[4];
+	/// Expands the colour bytes to the SPI bitstream
+	SpiClocklessEncoder _encoder;
 	
-	ColorRgbw _temp_rgbw;
+	/// The converted rgbw values of the current frame
+	std::vector<ColorRgbw> _rgbwValues;
 };
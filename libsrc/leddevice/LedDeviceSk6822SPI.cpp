@@ -34,21 +34,18 @@ Reset time:
 using the min of  2000000, the bit time is 0.500
 Reset time is 50uS = 100 bits = 13 bytes
 
+A 3 bit encoding can't reach the 1:4 high time ratio of T0H and T1H, so this device always uses 4 bits.
+
 */
 
 
 LedDeviceSk6822SPI::LedDeviceSk6822SPI(const QJsonObject &deviceConfig)
 	: ProviderSpi()
-	, SPI_BYTES_PER_COLOUR(4)
 	, SPI_BYTES_WAIT_TIME(3)
 	, SPI_FRAME_END_LATCH_BYTES(13)
-	, bitpair_to_byte {
-		0b10001000,
-		0b10001110,
-		0b11101000,
-		0b11101110,
-	}
+	, _encoder(4, 0b1000, 0b1110)
 {
+	_multiOutputSupported = true;
 	_deviceReady = init(deviceConfig);
 }
 
@@ -66,30 +63,25 @@ bool LedDeviceSk6822SPI::init(const QJsonObject &deviceConfig)
 	}
 	WarningIf(( _baudRate_Hz < 2000000 || _baudRate_Hz > 2460000 ), _log, "SPI rate %d outside recommended range (2000000 -> 2460000)", _baudRate_Hz);
 
-	_ledBuffer.resize( (_ledRGBCount *  SPI_BYTES_PER_COLOUR) + (_ledCount * SPI_BYTES_WAIT_TIME ) + SPI_FRAME_END_LATCH_BYTES, 0x00);
-//	Debug(_log, "_ledBuffer.resize(_ledRGBCount:%d * SPI_BYTES_PER_COLOUR:%d) + ( _ledCount:%d * SPI_BYTES_WAIT_TIME:%d ) + SPI_FRAME_END_LATCH_BYTES:%d, 0x00)", _ledRGBCount, SPI_BYTES_PER_COLOUR, _ledCount, SPI_BYTES_WAIT_TIME,  SPI_FRAME_END_LATCH_BYTES);
+	for (SpiOutput& output : _outputs)
+	{
+		output.buffer.resize( (output.ledCount * sizeof(ColorRgb) * _encoder.bytesPerColorByte()) + (output.ledCount * SPI_BYTES_WAIT_TIME ) + SPI_FRAME_END_LATCH_BYTES, 0x00);
+	}
 
 	return true;
 }
 
 int LedDeviceSk6822SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgb) * SPI_BYTES_PER_COLOUR;
-
-	for (const ColorRgb& color : ledValues)
+	for (SpiOutput& output : _outputs)
 	{
-		uint32_t colorBits = ((unsigned int)color.red << 16)
-			| ((unsigned int)color.green << 8)
-			| color.blue;
+		uint8_t * spi_ptr = output.buffer.data();
 
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
+		for (unsigned i = output.ledStart; i < output.ledStart + output.ledCount; ++i)
 		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
+			spi_ptr  = _encoder.encode((const uint8_t *) &ledValues[i], sizeof(ColorRgb), spi_ptr);
+			spi_ptr += SPI_BYTES_WAIT_TIME;	// the wait between led time is all zeros
 		}
-		spi_ptr += SPI_BYTES_PER_LED;
-		spi_ptr += SPI_BYTES_WAIT_TIME;	// the wait between led time is all zeros
 	}
 
 
@@ -97,16 +89,16 @@ int LedDeviceSk6822SPI::write(const std::vector<ColorRgb> &ledValues)
 // debug the whole SPI packet
 	char debug_line[2048];
 	int ptr=0;
-	for (unsigned int i=0; i < _ledBuffer.size(); i++)
+	for (unsigned int i=0; i < _outputs[0].buffer.size(); i++)
 	{
 		if (i%16 == 0)
 		{
 			ptr += snprintf (ptr+debug_line, sizeof(debug_line)-ptr, "%03x: ", i);
 		}
 
-		ptr += snprintf (ptr+debug_line, sizeof(debug_line)-ptr, "%02x ", _ledBuffer.data()[i]);
+		ptr += snprintf (ptr+debug_line, sizeof(debug_line)-ptr, "%02x ", _outputs[0].buffer.data()[i]);
 
-		if ( (i%16 == 15) || ( i == _ledBuffer.size()-1 ) )
+		if ( (i%16 == 15) || ( i == _outputs[0].buffer.size()-1 ) )
 		{
 			Debug(_log, debug_line);
 			ptr = 0;
@@ -114,5 +106,5 @@ int LedDeviceSk6822SPI::write(const std::vector<ColorRgb> &ledValues)
 	}
 */
 
-	return writeBytes(_ledBuffer.size(), _ledBuffer.data());
+	return writeOutputs();
 }
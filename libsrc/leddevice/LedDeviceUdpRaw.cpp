@@ -6,6 +6,7 @@ LedDeviceUdpRaw::LedDeviceUdpRaw(const QJsonObject &deviceConfig)
 	_LatchTime_ns = 500000;
 	_port = 5568;
 	init(deviceConfig);
+	_deltaOutput.init(deviceConfig);
 }
 
 LedDevice* LedDeviceUdpRaw::construct(const QJsonObject &deviceConfig)
@@ -15,6 +16,20 @@ LedDevice* LedDeviceUdpRaw::construct(const QJsonObject &deviceConfig)
 
 int LedDeviceUdpRaw::write(const std::vector<ColorRgb> &ledValues)
 {
+	// The raw protocol has no offsets, so a frame is either sent completely or skipped
+	if (_deltaOutput.isEnabled())
+	{
+		bool changed = _deltaOutput.beginFrame();
+		for (unsigned i = 0; i < ledValues.size(); i++)
+		{
+			changed |= _deltaOutput.isChanged(i, ledValues[i]);
+		}
+		if (!changed)
+		{
+			return 0;
+		}
+	}
+
 	const uint8_t * dataPtr = reinterpret_cast<const uint8_t *>(ledValues.data());
 
 	return writeBytes((unsigned)_ledRGBCount, dataPtr);
@@ -2,6 +2,7 @@
 
 // hyperion incluse
 #include "ProviderUdp.h"
+#include "DeltaOutput.h"
 
 ///
 /// Implementation of the LedDevice interface for sending led colors via udp.
@@ -26,4 +27,8 @@ public:
 	/// @return Zero on succes else negative
 	///
 	virtual int write(const std::vector<ColorRgb> &ledValues);
+
+private:
+	/// Skips unchanged frames between keyframes if enabled
+	DeltaOutput _deltaOutput;
 };
@@ -1,15 +1,24 @@
 #include "LedDeviceWs2812SPI.h"
 
+/*
+A '0' is sent as a short and a '1' as a long high pulse. With 4 SPI bits per data bit:
+T0 is sent as 1000
+T1 is sent as 1100
+
+With 3 SPI bits per data bit the frame is 25% shorter:
+T0 is sent as 100
+T1 is sent as 110
+
+T0H 0.35µs, T1H 0.7µs (±150ns) and a bit period of 1.25µs (±600ns) give the usable rates:
+4 bits: 2050000 -> 4000000
+3 bits: 2400000 -> 3600000
+*/
+
 LedDeviceWs2812SPI::LedDeviceWs2812SPI(const QJsonObject &deviceConfig)
 	: ProviderSpi()
-	, SPI_BYTES_PER_COLOUR(4)
-	, bitpair_to_byte {
-		0b10001000,
-		0b10001100,
-		0b11001000,
-		0b11001100,
-	}
+	, _encoder(4, 0b1000, 0b1100)
 {
+	_multiOutputSupported = true;
 	_deviceReady = init(deviceConfig);
 }
 
@@ -20,41 +29,54 @@ LedDevice* LedDeviceWs2812SPI::construct(const QJsonObject &deviceConfig)
 
 bool LedDeviceWs2812SPI::init(const QJsonObject &deviceConfig)
 {
+	const int bitsPerSymbol = deviceConfig["bitsPerSymbol"].toInt(4);
+	if (bitsPerSymbol == 3)
+	{
+		_encoder = SpiClocklessEncoder(3, 0b100, 0b110);
+	}
+	else if (bitsPerSymbol == 4)
+	{
+		_encoder = SpiClocklessEncoder(4, 0b1000, 0b1100);
+	}
+	else
+	{
+		Error(_log, "unsupported bitsPerSymbol %d (3 or 4)", bitsPerSymbol);
+		return false;
+	}
+
 	_baudRate_Hz = 3000000;
 	if ( !ProviderSpi::init(deviceConfig) )
 	{
 		return false;
 	}
-	WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
+	if (bitsPerSymbol == 3)
+	{
+		WarningIf(( _baudRate_Hz < 2400000 || _baudRate_Hz > 3600000 ), _log, "SPI rate %d outside recommended range (2400000 -> 3600000)", _baudRate_Hz);
+	}
+	else
+	{
+		WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
+	}
 
 	const int SPI_FRAME_END_LATCH_BYTES = 3;
-	_ledBuffer.resize(_ledRGBCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, 0x00);
+	for (SpiOutput& output : _outputs)
+	{
+		output.buffer.resize(output.ledCount * sizeof(ColorRgb) * _encoder.bytesPerColorByte() + SPI_FRAME_END_LATCH_BYTES, 0x00);
+	}
 
 	return true;
 }
 
 int LedDeviceWs2812SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgb) * SPI_BYTES_PER_COLOUR;
-
-	for (const ColorRgb& color : ledValues)
+	for (SpiOutput& output : _outputs)
 	{
-		uint32_t colorBits = ((unsigned int)color.red << 16)
-			| ((unsigned int)color.green << 8)
-			| color.blue;
+		const uint8_t * spi_end = output.buffer.data() + output.buffer.size();
+		uint8_t * spi_ptr = _encoder.encode((const uint8_t *) (ledValues.data() + output.ledStart), output.ledCount * sizeof(ColorRgb), output.buffer.data());
 
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
-		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
-		}
-		spi_ptr += SPI_BYTES_PER_LED;
+		// latch
+		memset(spi_ptr, 0, spi_end - spi_ptr);
 	}
 
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
-
-	return writeBytes(_ledBuffer.size(), _ledBuffer.data());
+	return writeOutputs();
 }
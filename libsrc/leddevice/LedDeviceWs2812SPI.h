@@ -2,6 +2,7 @@
 
 // hyperion incluse
 #include "ProviderSpi.h"
+#include "SpiClocklessEncoder.h"
 
 ///
 /// Implementation of the LedDevice interface for writing to Ws2812 led device via spi.
@@ -35,7 +36,6 @@ private:
 	///
 	virtual int write(const std::vector<ColorRgb> &ledValues);
 
-        const int SPI_BYTES_PER_COLOUR;
-
-	uint8_t bitpair_to_byte[4];
+	/// Expands the colour bytes to the SPI bitstream
+	SpiClocklessEncoder _encoder;
 };
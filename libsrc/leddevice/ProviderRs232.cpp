@@ -12,6 +12,12 @@
 // Local Hyperion includes
 #include "ProviderRs232.h"
 
+/// Time after which an unchanged frame is sent anyway, keeps devices with a data timeout alive
+static const qint64 UNCHANGED_FRAME_REWRITE_MS = 1000;
+
+/// Time after which a write that never completed frees the port
+static const int WRITE_TIMEOUT_MS = 5000;
+
 ProviderRs232::ProviderRs232()
 	: _rs232Port(this)
 	, _blockedForDelay(false)
@@ -23,10 +29,22 @@ ProviderRs232::ProviderRs232()
 	, _preOpenDelayTimeOut(0)
 	, _preOpenDelay(2000)
 	, _enableAutoDeviceName(false)
+	, _pendingFrame()
+	, _lastFrame()
+	, _lastFrameTime(0)
+	, _transmitTimer()
+	, _writeTimer()
+	, _skipUnchanged(false)
 {
+	_transmitTimer.setSingleShot(true);
+	_writeTimer.setSingleShot(true);
+	_writeTimer.setInterval(WRITE_TIMEOUT_MS);
+
 	connect(&_rs232Port, SIGNAL(error(QSerialPort::SerialPortError)), this, SLOT(error(QSerialPort::SerialPortError)));
 	connect(&_rs232Port, SIGNAL(bytesWritten(qint64)), this, SLOT(bytesWritten(qint64)));
 	connect(&_rs232Port, SIGNAL(readyRead()), this, SLOT(readyRead()));
+	connect(&_transmitTimer, SIGNAL(timeout()), this, SLOT(writePendingFrame()));
+	connect(&_writeTimer, SIGNAL(timeout()), this, SLOT(writeTimeout()));
 }
 
 bool ProviderRs232::init(const QJsonObject &deviceConfig)
@@ -40,6 +58,7 @@ bool ProviderRs232::init(const QJsonObject &deviceConfig)
 	_baudRate_Hz          = deviceConfig["rate"].toInt();
 	_delayAfterConnect_ms = deviceConfig["delayAfterConnect"].toInt(1500);
 	_preOpenDelay         = deviceConfig["delayBeforeConnect"].toInt(1500);
+	_skipUnchanged        = deviceConfig["skipUnchanged"].toBool(false);
 
 	return true;
 }
@@ -62,10 +81,11 @@ QString ProviderRs232::findSerialDevice()
 void ProviderRs232::bytesWritten(qint64 bytes)
 {
 	_bytesWritten += bytes;
-	if (_bytesWritten >= _bytesToWrite)
+	if (_bytesToWrite > 0 && _bytesWritten >= _bytesToWrite)
 	{
 		_bytesToWrite = 0;
-		_blockedForDelay = false;
+		_writeTimer.stop();
+		writePendingFrame();
 	}
 }
 
@@ -132,6 +152,11 @@ ProviderRs232::~ProviderRs232()
 
 void ProviderRs232::closeDevice()
 {
+	_bytesToWrite = 0;
+	_pendingFrame.clear();
+	_transmitTimer.stop();
+	_writeTimer.stop();
+
 	if (_rs232Port.isOpen())
 	{
 		_rs232Port.close();
@@ -204,41 +229,76 @@ bool ProviderRs232::tryOpen(const int delayAfterConnect_ms)
 
 int ProviderRs232::writeBytes(const qint64 size, const uint8_t * data)
 {
-	if (! _blockedForDelay)
+	if (!_blockedForDelay && !_rs232Port.isOpen())
 	{
-		if (!_rs232Port.isOpen())
-		{
-			return tryOpen(5000) ? 0 : -1;
-		}
-
-		if (_frameDropCounter > 5)
-		{
-			Debug(_log, "%d frames dropped", _frameDropCounter);
-		}
-		_frameDropCounter = 0;
-		_blockedForDelay = true;
-		_bytesToWrite = size;
-		qint64 bytesWritten = _rs232Port.write(reinterpret_cast<const char*>(data), size);
-		if (bytesWritten == -1 || bytesWritten != size)
-		{
-			Warning(_log,"failed writing data");
-			QTimer::singleShot(500, this, SLOT(unblockAfterDelay()));
-			return -1;
-		}
-		QTimer::singleShot(5000, this, SLOT(unblockAfterDelay()));
+		return tryOpen(5000) ? 0 : -1;
 	}
-	else
+
+	// a frame still waiting for the port is superseded by the newer one
+	if (!_pendingFrame.isEmpty())
 	{
 		_frameDropCounter++;
 	}
+	_pendingFrame = QByteArray(reinterpret_cast<const char*>(data), size);
+
+	return writePendingFrame();
+}
+
+int ProviderRs232::writePendingFrame()
+{
+	if (_pendingFrame.isEmpty() || _blockedForDelay || _bytesToWrite > 0 || _transmitTimer.isActive() || !_rs232Port.isOpen())
+	{
+		return 0;
+	}
+
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	if (_skipUnchanged && _pendingFrame == _lastFrame && now - _lastFrameTime < UNCHANGED_FRAME_REWRITE_MS)
+	{
+		_pendingFrame.clear();
+		return 0;
+	}
+
+	if (_frameDropCounter > 5)
+	{
+		Debug(_log, "%d frames dropped", _frameDropCounter);
+	}
+	_frameDropCounter = 0;
+
+	_lastFrame.swap(_pendingFrame);
+	_pendingFrame.clear();
+	_lastFrameTime = now;
+
+	_bytesToWrite = _lastFrame.size();
+	_bytesWritten = 0;
+	qint64 bytesWritten = _rs232Port.write(_lastFrame);
+	if (bytesWritten == -1 || bytesWritten != _lastFrame.size())
+	{
+		Warning(_log,"failed writing data");
+		_bytesToWrite = 0;
+		return -1;
+	}
+	_writeTimer.start();
+
+	// 10 bits per byte on the line (start, 8 data and stop bit)
+	if (_baudRate_Hz > 0)
+	{
+		_transmitTimer.start(int((bytesWritten * 10 * 1000 + _baudRate_Hz - 1) / _baudRate_Hz));
+	}
 
 	return 0;
 }
 
+void ProviderRs232::writeTimeout()
+{
+	Warning(_log, "writing data timed out");
+	_bytesToWrite = 0;
+	writePendingFrame();
+}
 
 void ProviderRs232::unblockAfterDelay()
 {
 	_blockedForDelay = false;
+	writePendingFrame();
 }
 
 int ProviderRs232::rewriteLeds()
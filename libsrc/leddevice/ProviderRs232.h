@@ -50,12 +50,25 @@ private slots:
 	void bytesWritten(qint64 bytes);
 	void readyRead();
 
+	///
+	/// Hands the newest pending frame to the serial port, if the port is free. The port is free
+	/// when the previous frame is completely written and its transmission time has passed.
+	///
+	/// @return Zero on success (or nothing to write) else negative
+	///
+	int writePendingFrame();
+
+	/// Frees the port if the previous write never completed
+	void writeTimeout();
+
 signals:
 	void receivedData(QByteArray data);
 
 protected:
 	/**
-	 * Writes the given bytes to the RS232-device and
+	 * Writes the given bytes to the RS232-device. If the previous frame is still being
+	 * transmitted, the bytes replace any frame waiting for the port and are sent as soon
+	 * as the port is free.
 	 *
 	 * @param[in[ size The length of the data
 	 * @param[in] data The data
@@ -95,4 +108,22 @@ protected:
 	qint64                       _preOpenDelayTimeOut;
 	int                          _preOpenDelay;
 	bool                         _enableAutoDeviceName;
+
+	/// The newest frame not yet handed to the port (empty if none)
+	QByteArray _pendingFrame;
+
+	/// The last frame handed to the port
+	QByteArray _lastFrame;
+
+	/// Time the last frame was handed to the port
+	qint64 _lastFrameTime;
+
+	/// Runs for the time the last frame needs on the line at the configured baudrate
+	QTimer _transmitTimer;
+
+	/// Fallback if the port never reports the last frame as written
+	QTimer _writeTimer;
+
+	/// Don't resend a frame equal to the last one (but still at least once per second)
+	bool _skipUnchanged;
 };
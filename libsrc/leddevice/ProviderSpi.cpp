@@ -7,40 +7,167 @@
 
 // Linux includes
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+
+// Qt includes
+#include <QJsonArray>
+#include <QThread>
 
 // Local Hyperion includes
 #include "ProviderSpi.h"
 #include <utils/Logger.h>
 
+///
+/// Writes the buffer of one output for every frame released by ProviderSpi::writeOutputs()
+///
+class SpiOutputThread : public QThread
+{
+public:
+	SpiOutputThread(ProviderSpi * provider, const unsigned index)
+		: QThread()
+		, _provider(provider)
+		, _index(index)
+		, _frameNumber(provider->_frameNumber)
+	{
+	}
+
+protected:
+	virtual void run()
+	{
+		ProviderSpi::SpiOutput & output = _provider->_outputs[_index];
+
+		QMutexLocker lock(&_provider->_frameMutex);
+		while (true)
+		{
+			while (!_provider->_stopOutputs && _provider->_frameNumber == _frameNumber)
+			{
+				_provider->_frameStart.wait(&_provider->_frameMutex);
+			}
+			if (_provider->_stopOutputs)
+			{
+				break;
+			}
+			_frameNumber = _provider->_frameNumber;
+
+			lock.unlock();
+			_provider->transfer(output, output.buffer.size(), output.buffer.data());
+			lock.relock();
+
+			if (--_provider->_pendingOutputs == 0)
+			{
+				_provider->_frameDone.wakeAll();
+			}
+		}
+	}
+
+private:
+	ProviderSpi * _provider;
+	const unsigned _index;
+	unsigned _frameNumber;
+};
 
 ProviderSpi::ProviderSpi()
 	: LedDevice()
-	, _deviceName("/dev/spidev0.0")
+	, _outputs()
+	, _multiOutputSupported(false)
 	, _baudRate_Hz(1000000)
 	, _latchTime_ns(0)
-	, _fid(-1)
 	, _spiMode(SPI_MODE_0)
 	, _spiDataInvert(false)
+	, _outputThreads()
+	, _frameNumber(0)
+	, _pendingOutputs(0)
+	, _stopOutputs(false)
 {
-	memset(&_spi, 0, sizeof(_spi));
 }
 
 ProviderSpi::~ProviderSpi()
 {
-//	close(_fid);
+	stopOutputThreads();
+
+	for (SpiOutput & output : _outputs)
+	{
+		if (output.fid >= 0)
+		{
+			close(output.fid);
+		}
+	}
 }
 
 bool ProviderSpi::init(const QJsonObject &deviceConfig)
 {
 	LedDevice::init(deviceConfig);
 
-	_deviceName    = deviceConfig["output"].toString(QString::fromStdString(_deviceName)).toStdString();
 	_baudRate_Hz   = deviceConfig["rate"].toInt(_baudRate_Hz);
 	_latchTime_ns  = deviceConfig["latchtime"].toInt(_latchTime_ns);
 	_spiMode       = deviceConfig["spimode"].toInt(_spiMode);
 	_spiDataInvert = deviceConfig["invert"].toBool(_spiDataInvert);
-	
+
+	// name and led count per output, -1 shares the unassigned leds
+	std::vector<std::pair<std::string, int>> outputs;
+	const QJsonArray outputsConfig = deviceConfig["outputs"].toArray();
+	if (outputsConfig.isEmpty())
+	{
+		outputs.emplace_back(deviceConfig["output"].toString("/dev/spidev0.0").toStdString(), _ledCount);
+	}
+	for (const QJsonValue & outputConfig : outputsConfig)
+	{
+		outputs.emplace_back(outputConfig.toObject()["output"].toString().toStdString(), outputConfig.toObject()["leds"].toInt(-1));
+	}
+
+	int assignedLeds = 0;
+	int sharedOutputs = 0;
+	for (const auto & output : outputs)
+	{
+		if (output.second < 0)
+		{
+			++sharedOutputs;
+		}
+		else
+		{
+			assignedLeds += output.second;
+		}
+	}
+	if (assignedLeds > _ledCount)
+	{
+		Error(_log, "The SPI outputs are configured for %d leds, but only %d leds exist", assignedLeds, _ledCount);
+		return false;
+	}
+
+	int sharedLeds = _ledCount - assignedLeds;
+	unsigned ledStart = 0;
+	_outputs.clear();
+	for (const auto & outputConfig : outputs)
+	{
+		int ledCount = outputConfig.second;
+		if (ledCount < 0)
+		{
+			ledCount    = sharedLeds / sharedOutputs--;
+			sharedLeds -= ledCount;
+		}
+
+		SpiOutput output;
+		output.deviceName = outputConfig.first;
+		output.ledStart   = ledStart;
+		output.ledCount   = ledCount;
+		output.fid        = -1;
+		output.isFile     = false;
+		output.result     = 0;
+		output.error      = 0;
+		_outputs.push_back(output);
+
+		ledStart += ledCount;
+	}
+	WarningIf((int(ledStart) < _ledCount), _log, "%d leds are not assigned to a SPI output", _ledCount - int(ledStart));
+
+	if (_outputs.size() > 1 && !_multiOutputSupported)
+	{
+		Error(_log, "This device supports a single SPI output only");
+		return false;
+	}
+
 	return true;
 }
 
@@ -51,64 +178,185 @@ int ProviderSpi::open()
 
 	const int bitsPerWord = 8;
 
-	_fid = ::open(_deviceName.c_str(), O_RDWR);
-
-	if (_fid < 0)
+	for (SpiOutput & output : _outputs)
 	{
-		Error( _log, "Failed to open device (%s). Error message: %s", _deviceName.c_str(),  strerror(errno) );
-		return -1;
+		struct stat fileStat;
+		output.isFile = (stat(output.deviceName.c_str(), &fileStat) == 0)
+			? S_ISREG(fileStat.st_mode)
+			: output.deviceName.compare(0, 5, "/dev/") != 0;
+
+		output.fid = output.isFile
+			? ::open(output.deviceName.c_str(), O_WRONLY | O_CREAT, 0644)
+			: ::open(output.deviceName.c_str(), O_RDWR);
+
+		if (output.fid < 0)
+		{
+			Error( _log, "Failed to open device (%s). Error message: %s", output.deviceName.c_str(),  strerror(errno) );
+			return -1;
+		}
+
+		if (output.isFile)
+		{
+			Info(_log, "Writing %u leds starting at led %u to file %s", output.ledCount, output.ledStart, output.deviceName.c_str());
+			continue;
+		}
+
+		if (ioctl(output.fid, SPI_IOC_WR_MODE, &_spiMode) == -1 || ioctl(output.fid, SPI_IOC_RD_MODE, &_spiMode) == -1)
+		{
+			return -2;
+		}
+
+		if (ioctl(output.fid, SPI_IOC_WR_BITS_PER_WORD, &bitsPerWord) == -1 || ioctl(output.fid, SPI_IOC_RD_BITS_PER_WORD, &bitsPerWord) == -1)
+		{
+			return -4;
+		}
+
+		if (ioctl(output.fid, SPI_IOC_WR_MAX_SPEED_HZ, &_baudRate_Hz) == -1 || ioctl(output.fid, SPI_IOC_RD_MAX_SPEED_HZ, &_baudRate_Hz) == -1)
+		{
+			return -6;
+		}
 	}
 
-	if (ioctl(_fid, SPI_IOC_WR_MODE, &_spiMode) == -1 || ioctl(_fid, SPI_IOC_RD_MODE, &_spiMode) == -1)
+	// the first output is written by the calling thread
+	for (unsigned i = 1; i < _outputs.size(); ++i)
 	{
-		return -2;
+		SpiOutputThread * thread = new SpiOutputThread(this, i);
+		_outputThreads.push_back(thread);
+		thread->start();
 	}
 
-	if (ioctl(_fid, SPI_IOC_WR_BITS_PER_WORD, &bitsPerWord) == -1 || ioctl(_fid, SPI_IOC_RD_BITS_PER_WORD, &bitsPerWord) == -1)
+	return 0;
+}
+
+int ProviderSpi::transfer(SpiOutput &output, const unsigned size, const uint8_t * data)
+{
+	if (_spiDataInvert)
 	{
-		return -4;
+		output.invertBuffer.resize(size);
+		for (unsigned i = 0; i<size; i++) {
+			output.invertBuffer[i] = data[i] ^ 0xff;
+		}
+		data = output.invertBuffer.data();
 	}
 
-	if (ioctl(_fid, SPI_IOC_WR_MAX_SPEED_HZ, &_baudRate_Hz) == -1 || ioctl(_fid, SPI_IOC_RD_MAX_SPEED_HZ, &_baudRate_Hz) == -1)
+	if (output.isFile)
 	{
-		return -6;
+		// the file holds the latest frame only
+		const bool ok = pwrite(output.fid, data, size, 0) == ssize_t(size) && ftruncate(output.fid, size) == 0;
+		output.result = ok ? int(size) : -1;
 	}
+	else
+	{
+		spi_ioc_transfer spi;
+		memset(&spi, 0, sizeof(spi));
+		spi.tx_buf = __u64(data);
+		spi.len    = __u32(size);
 
-	return 0;
+		output.result = ioctl(output.fid, SPI_IOC_MESSAGE(1), &spi);
+	}
+	output.error = (output.result < 0) ? errno : 0;
+
+	return output.result;
+}
+
+void ProviderSpi::latch()
+{
+	if (_latchTime_ns > 0)
+	{
+		// The 'latch' time for latching the shifted-value into the leds
+		timespec latchTime;
+		latchTime.tv_sec  = 0;
+		latchTime.tv_nsec = _latchTime_ns;
+
+		nanosleep(&latchTime, NULL);
+	}
 }
 
 int ProviderSpi::writeBytes(const unsigned size, const uint8_t * data)
 {
-	if (_fid < 0)
+	if (_outputs.empty() || _outputs[0].fid < 0)
 	{
 		return -1;
 	}
 
-	_spi.tx_buf = __u64(data);
-	_spi.len    = __u32(size);
+	SpiOutput & output = _outputs[0];
+	int retVal = transfer(output, size, data);
+	ErrorIf((retVal < 0), _log, "SPI failed to write. errno: %d, %s", output.error,  strerror(output.error) );
 
-	if (_spiDataInvert)
+	// Sleep to latch the leds (only if write succesfull)
+	if (retVal >= 0)
 	{
-		uint8_t * newdata = (uint8_t *)malloc(size);
-		for (unsigned i = 0; i<size; i++) {
-			newdata[i] = data[i] ^ 0xff;
+		latch();
+	}
+
+	return retVal;
+}
+
+int ProviderSpi::writeOutputs()
+{
+	if (_outputs.empty())
+	{
+		return -1;
+	}
+
+	for (const SpiOutput & output : _outputs)
+	{
+		if (output.fid < 0)
+		{
+			return -1;
 		}
-		_spi.tx_buf = __u64(newdata);
 	}
 
-	int retVal = ioctl(_fid, SPI_IOC_MESSAGE(1), &_spi);
-	ErrorIf((retVal < 0), _log, "SPI failed to write. errno: %d, %s", errno,  strerror(errno) );
+	if (!_outputThreads.empty())
+	{
+		QMutexLocker lock(&_frameMutex);
+		_pendingOutputs = _outputThreads.size();
+		++_frameNumber;
+		_frameStart.wakeAll();
+	}
+
+	transfer(_outputs[0], _outputs[0].buffer.size(), _outputs[0].buffer.data());
 
-	if (retVal >= 0 && _latchTime_ns > 0)
+	if (!_outputThreads.empty())
 	{
-		// The 'latch' time for latching the shifted-value into the leds
-		timespec latchTime;
-		latchTime.tv_sec  = 0;
-		latchTime.tv_nsec = _latchTime_ns;
+		// frame barrier, latch only when every segment is shifted out
+		QMutexLocker lock(&_frameMutex);
+		while (_pendingOutputs > 0)
+		{
+			_frameDone.wait(&_frameMutex);
+		}
+	}
 
-		// Sleep to latch the leds (only if write succesfull)
-		nanosleep(&latchTime, NULL);
+	int retVal = 0;
+	for (const SpiOutput & output : _outputs)
+	{
+		if (output.result < 0)
+		{
+			Error(_log, "SPI failed to write to %s. errno: %d, %s", output.deviceName.c_str(), output.error, strerror(output.error));
+			retVal = output.result;
+		}
+	}
+
+	if (retVal >= 0)
+	{
+		latch();
 	}
 
 	return retVal;
 }
+
+void ProviderSpi::stopOutputThreads()
+{
+	{
+		QMutexLocker lock(&_frameMutex);
+		_stopOutputs = true;
+		_frameStart.wakeAll();
+	}
+
+	for (SpiOutputThread * thread : _outputThreads)
+	{
+		thread->wait();
+		delete thread;
+	}
+	_outputThreads.clear();
+}
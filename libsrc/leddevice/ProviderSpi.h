@@ -3,14 +3,26 @@
 // Linux-SPI includes
 #include <linux/spi/spidev.h>
 
+// Qt includes
+#include <QMutex>
+#include <QWaitCondition>
+
 // Hyperion includes
 #include <leddevice/LedDevice.h>
 
+class SpiOutputThread;
+
 ///
 /// The ProviderSpi implements an abstract base-class for LedDevices using the SPI-device.
 ///
+/// The leds can be split across several SPI devices ("outputs"), which are written concurrently.
+/// An output path pointing to a regular file (or any path outside /dev) writes every frame to
+/// that file instead, which can be used to test devices without SPI hardware.
+///
 class ProviderSpi : public LedDevice
 {
+	friend class SpiOutputThread;
+
 public:
 	///
 	/// Constructs specific LedDevice
@@ -25,20 +37,43 @@ public:
 	virtual bool init(const QJsonObject &deviceConfig);
 
 	///
-	/// Destructor of the LedDevice; closes the output device if it is open
+	/// Destructor of the LedDevice; closes the output devices if they are open
 	///
 	virtual ~ProviderSpi();
 
 	///
-	/// Opens and configures the output device
+	/// Opens and configures the output devices
 	///
 	/// @return Zero on succes else negative
 	///
 	int open();
 
 protected:
+	/// One SPI device driving a consecutive range of leds
+	struct SpiOutput
+	{
+		/// The name of the output device
+		std::string deviceName;
+		/// The index of the first led on this output
+		unsigned ledStart;
+		/// The number of leds on this output
+		unsigned ledCount;
+		/// The File Identifier of the opened output device (or -1 if not opened)
+		int fid;
+		/// true when the output is a regular file instead of a spi-device
+		bool isFile;
+		/// The bytes to write with writeOutputs(), filled by the device
+		std::vector<uint8_t> buffer;
+		/// Scratch buffer for the inverted data pattern
+		std::vector<uint8_t> invertBuffer;
+		/// The result of the last transfer
+		int result;
+		/// The errno of the last failed transfer
+		int error;
+	};
+
 	///
-	/// Writes the given bytes/bits to the SPI-device and sleeps the latch time to ensure that the
+	/// Writes the given bytes/bits to the (first) SPI-device and sleeps the latch time to ensure that the
 	/// values are latched.
 	///
 	/// @param[in[ size The length of the data
@@ -48,8 +83,19 @@ protected:
 	///
 	int writeBytes(const unsigned size, const uint8_t *data);
 
-	/// The name of the output device
-	std::string _deviceName;
+	///
+	/// Writes the buffer of every output. The transfers of all outputs are started together and the
+	/// call returns when all of them are finished, followed by a single latch time.
+	///
+	/// @return Zero on succes else negative
+	///
+	int writeOutputs();
+
+	/// The configured outputs, at least one after init()
+	std::vector<SpiOutput> _outputs;
+
+	/// true if the device fills the buffer of every output and writes with writeOutputs()
+	bool _multiOutputSupported;
 
 	/// The used baudrate of the output device
 	int _baudRate_Hz;
@@ -57,15 +103,34 @@ protected:
 	/// The time which the device should be untouched after a write
 	int _latchTime_ns;
 
-	/// The File Identifier of the opened output device (or -1 if not opened)
-	int _fid;
-
 	/// which spi clock mode do we use? (0..3)
 	int _spiMode;
 
 	/// 1=>invert the data pattern
 	bool _spiDataInvert;
 
-	/// The transfer structure for writing to the spi-device
-	spi_ioc_transfer _spi;
+private:
+	///
+	/// Writes the given bytes to a single output, safe to call from the output threads
+	///
+	/// @return the transfer result, negative on error
+	///
+	int transfer(SpiOutput &output, const unsigned size, const uint8_t *data);
+
+	/// Sleeps the latch time
+	void latch();
+
+	/// Stops and deletes the output threads
+	void stopOutputThreads();
+
+	/// The threads writing the outputs beyond the first one
+	std::vector<SpiOutputThread*> _outputThreads;
+
+	/// Frame barrier of the output threads
+	QMutex _frameMutex;
+	QWaitCondition _frameStart;
+	QWaitCondition _frameDone;
+	unsigned _frameNumber;
+	unsigned _pendingOutputs;
+	bool _stopOutputs;
 };
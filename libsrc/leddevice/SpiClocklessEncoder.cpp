@@ -0,0 +1,24 @@
+// Local Hyperion includes
+#include "SpiClocklessEncoder.h"
+
+SpiClocklessEncoder::SpiClocklessEncoder(const unsigned bitsPerSymbol, const uint8_t zeroSymbol, const uint8_t oneSymbol)
+	: _bitsPerSymbol(bitsPerSymbol == 3 ? 3 : 4)
+{
+	const uint32_t symbolMask = (1u << _bitsPerSymbol) - 1;
+
+	for (unsigned value = 0; value < 256; ++value)
+	{
+		// concatenate the symbols of all 8 data bits, msb first
+		uint32_t bits = 0;
+		for (int bit = 7; bit >= 0; --bit)
+		{
+			bits = (bits << _bitsPerSymbol) | (((value >> bit) & 1 ? oneSymbol : zeroSymbol) & symbolMask);
+		}
+
+		memset(_table[value], 0, sizeof(_table[value]));
+		for (unsigned byte = 0; byte < _bitsPerSymbol; ++byte)
+		{
+			_table[value][byte] = uint8_t(bits >> (8 * (_bitsPerSymbol - 1 - byte)));
+		}
+	}
+}
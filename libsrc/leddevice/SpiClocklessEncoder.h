@@ -0,0 +1,68 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <cstring>
+
+///
+/// Encodes colour bytes into the SPI bitstream of clockless (single wire) leds like the WS2812.
+/// Every led data bit is sent as a symbol of 3 or 4 SPI bits, so every colour byte expands to
+/// exactly 3 or 4 SPI bytes. The expansion of all 256 byte values is precomputed once, which
+/// turns the encoding into a single table lookup per colour byte.
+///
+class SpiClocklessEncoder
+{
+public:
+	///
+	/// Constructs the encoder and builds the expansion table
+	///
+	/// @param bitsPerSymbol The number of SPI bits per led data bit (3 or 4)
+	/// @param zeroSymbol The SPI bit pattern of a '0' data bit (lowest bitsPerSymbol bits)
+	/// @param oneSymbol The SPI bit pattern of a '1' data bit (lowest bitsPerSymbol bits)
+	///
+	SpiClocklessEncoder(const unsigned bitsPerSymbol, const uint8_t zeroSymbol, const uint8_t oneSymbol);
+
+	///
+	/// @return The number of SPI bytes a single colour byte expands to
+	///
+	inline unsigned bytesPerColorByte() const
+	{
+		return _bitsPerSymbol;
+	}
+
+	///
+	/// Encodes the given colour bytes
+	///
+	/// @param[in] data The colour bytes
+	/// @param[in] size The number of colour bytes
+	/// @param[out] output The SPI buffer, must hold size * bytesPerColorByte() bytes
+	///
+	/// @return Pointer behind the last written SPI byte
+	///
+	inline uint8_t* encode(const uint8_t* data, const unsigned size, uint8_t* output) const
+	{
+		// fixed size copies compile to a single load/store per colour byte
+		if (_bitsPerSymbol == 4)
+		{
+			for (unsigned i = 0; i < size; ++i, output += 4)
+			{
+				memcpy(output, _table[data[i]], 4);
+			}
+		}
+		else
+		{
+			for (unsigned i = 0; i < size; ++i, output += 3)
+			{
+				memcpy(output, _table[data[i]], 3);
+			}
+		}
+		return output;
+	}
+
+private:
+	/// The number of SPI bits per led data bit
+	unsigned _bitsPerSymbol;
+
+	/// The SPI bytes (in transmission order) of every colour byte value
+	uint8_t _table[256][4];
+};
@@ -0,0 +1,90 @@
+// protoserver includes
+#include "ImageEncoding.h"
+
+namespace ImageEncoding {
+
+QByteArray encodeRowDelta(const Image<ColorRgb> & image)
+{
+	const int rowSize = image.width() * 3;
+	const int dataSize = rowSize * image.height();
+	const uint8_t * pixels = reinterpret_cast<const uint8_t *>(image.memptr());
+
+	QByteArray delta(dataSize, Qt::Uninitialized);
+	uint8_t * out = reinterpret_cast<uint8_t *>(delta.data());
+
+	// first row is stored as it is, all others as difference to the row above
+	memcpy(out, pixels, std::min(rowSize, dataSize));
+	for (int i = rowSize; i < dataSize; ++i)
+	{
+		out[i] = uint8_t(pixels[i] - pixels[i - rowSize]);
+	}
+
+	return qCompress(delta, 1);
+}
+
+bool decodeRowDelta(const std::string & data, Image<ColorRgb> & image)
+{
+	const qint64 rowSize = qint64(image.width()) * 3;
+	const qint64 dataSize = rowSize * image.height();
+
+	// qCompress prepends the uncompressed size (big endian), reject other sizes before inflating
+	if (data.size() < 4)
+	{
+		return false;
+	}
+	const uint8_t * header = reinterpret_cast<const uint8_t *>(data.data());
+	const qint64 expectedSize = (qint64(header[0]) << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+	if (expectedSize != dataSize)
+	{
+		return false;
+	}
+
+	const QByteArray delta = qUncompress(reinterpret_cast<const uchar *>(data.data()), int(data.size()));
+	if (delta.size() != dataSize)
+	{
+		return false;
+	}
+
+	const uint8_t * in = reinterpret_cast<const uint8_t *>(delta.constData());
+	uint8_t * pixels = reinterpret_cast<uint8_t *>(image.memptr());
+
+	memcpy(pixels, in, size_t(std::min(rowSize, dataSize)));
+	for (qint64 i = rowSize; i < dataSize; ++i)
+	{
+		pixels[i] = uint8_t(in[i] + pixels[i - rowSize]);
+	}
+
+	return true;
+}
+
+void downscale(const Image<ColorRgb> & image, const unsigned factor, Image<ColorRgb> & output)
+{
+	const unsigned width  = image.width()  / factor;
+	const unsigned height = image.height() / factor;
+	const unsigned blockSize = factor * factor;
+	output.resize(width, height);
+
+	// the pixels are detached once, not per output pixel
+	ColorRgb * outputPixel = output.memptr();
+	const ColorRgb * pixels = image.memptr();
+	for (unsigned y = 0; y < height; ++y)
+	{
+		for (unsigned x = 0; x < width; ++x, ++outputPixel)
+		{
+			unsigned red = 0, green = 0, blue = 0;
+			for (unsigned yBlock = y * factor; yBlock < (y + 1) * factor; ++yBlock)
+			{
+				const ColorRgb * pixel = pixels + size_t(yBlock) * image.width() + x * factor;
+				for (unsigned xBlock = 0; xBlock < factor; ++xBlock, ++pixel)
+				{
+					red   += pixel->red;
+					green += pixel->green;
+					blue  += pixel->blue;
+				}
+			}
+			*outputPixel = ColorRgb{uint8_t(red / blockSize), uint8_t(green / blockSize), uint8_t(blue / blockSize)};
+		}
+	}
+}
+
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+// STL includes
+#include <string>
+
+// Qt includes
+#include <QByteArray>
+
+// hyperion util
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// Encoding and scaling helpers for the image transport of the proto protocol
+///
+namespace ImageEncoding {
+
+	/// Largest width and height of a received image
+	const int MAX_IMAGE_DIMENSION = 8192;
+
+	/// Prefix of the keys of the shared memory image rings, followed by "<pid>-<generation>"
+	const char SHARED_MEMORY_KEY_PREFIX[] = "hyperion-proto-";
+
+	///
+	/// Losslessly encodes the image: every row is replaced by its difference to the previous row
+	/// and the result is zlib compressed (fast level)
+	///
+	/// @param image The image to encode
+	/// @return The encoded image data
+	///
+	QByteArray encodeRowDelta(const Image<ColorRgb> & image);
+
+	///
+	/// Decodes image data created by encodeRowDelta()
+	///
+	/// @param data The encoded image data
+	/// @param[out] image The decoded image, must have the size of the encoded image
+	/// @return true if the data could be decoded into the image, false if the size of the data
+	/// (as stored in the compressed data) does not match with the image
+	///
+	bool decodeRowDelta(const std::string & data, Image<ColorRgb> & image);
+
+	///
+	/// Downscales the image by averaging blocks of factor x factor pixels
+	///
+	/// @param image The image to scale
+	/// @param factor The scale factor (>1)
+	/// @param[out] output The scaled image
+	///
+	void downscale(const Image<ColorRgb> & image, const unsigned factor, Image<ColorRgb> & output);
+
+};
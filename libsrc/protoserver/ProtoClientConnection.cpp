@@ -11,6 +11,7 @@
 #include <QRgb>
 #include <QResource>
 #include <QDateTime>
+#include <QRegExp>
 
 // hyperion util includes
 #include "hyperion/ImageProcessorFactory.h"
@@ -19,6 +20,7 @@
 
 // project includes
 #include "ProtoClientConnection.h"
+#include "ImageEncoding.h"
 
 ProtoClientConnection::ProtoClientConnection(QTcpSocket *socket)
 	: QObject()
@@ -26,6 +28,8 @@ ProtoClientConnection::ProtoClientConnection(QTcpSocket *socket)
 	, _imageProcessor(ImageProcessorFactory::getInstance().newImageProcessor())
 	, _hyperion(Hyperion::getInstance())
 	, _receiveBuffer()
+	, _sharedMemory()
+	, _sharedMemoryImage()
 	, _priority(-1)
 {
 	// connect internal signals and slots
@@ -134,6 +138,22 @@ void ProtoClientConnection::handleMessage(const proto::HyperionRequest & message
 		}
 		handleImageCommand(message.GetExtension(proto::ImageRequest::imageRequest));
 		break;
+	case proto::HyperionRequest::SHMIMAGE:
+		if (!message.HasExtension(proto::SharedMemoryImageRequest::sharedMemoryImageRequest))
+		{
+			sendErrorReply("Received SHMIMAGE command without SharedMemoryImageRequest");
+			break;
+		}
+		handleSharedMemoryImageCommand(message.GetExtension(proto::SharedMemoryImageRequest::sharedMemoryImageRequest));
+		break;
+	case proto::HyperionRequest::LEDCOLORS:
+		if (!message.HasExtension(proto::LedColorsRequest::ledColorsRequest))
+		{
+			sendErrorReply("Received LEDCOLORS command without LedColorsRequest");
+			break;
+		}
+		handleLedColorsCommand(message.GetExtension(proto::LedColorsRequest::ledColorsRequest));
+		break;
 	case proto::HyperionRequest::CLEAR:
 		if (!message.HasExtension(proto::ClearRequest::clearRequest))
 		{
@@ -182,29 +202,154 @@ void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &messag
 	int height = message.imageheight();
 	const std::string & imageData = message.imagedata();
 
+	// check the image size before allocating the image
+	if (width <= 0 || height <= 0 || width > ImageEncoding::MAX_IMAGE_DIMENSION || height > ImageEncoding::MAX_IMAGE_DIMENSION)
+	{
+		sendErrorReply("Invalid image size");
+		return;
+	}
+
 	// check consistency of the size of the received data
-	if ((int) imageData.size() != width*height*3)
+	if (message.encoding() == proto::ImageRequest::RAW && qint64(imageData.size()) != qint64(width) * height * 3)
 	{
 		sendErrorReply("Size of image data does not match with the width and height");
 		return;
 	}
 
+	// create ImageRgb
+	Image<ColorRgb> image(width, height);
+	if (message.encoding() == proto::ImageRequest::ROWDELTA_ZLIB)
+	{
+		if (!ImageEncoding::decodeRowDelta(imageData, image))
+		{
+			sendErrorReply("Unable to decode image data");
+			return;
+		}
+	}
+	else
+	{
+		memcpy(image.memptr(), imageData.c_str(), imageData.size());
+	}
+
 	// set width and height of the image processor
 	_imageProcessor->setSize(width, height);
 
-	// create ImageRgb
-	Image<ColorRgb> image(width, height);
-	memcpy(image.memptr(), imageData.c_str(), imageData.size());
+	// process the image
+	std::vector<ColorRgb> ledColors = _imageProcessor->process(image);
+	_hyperion->setColors(_priority, ledColors, duration);
+	_hyperion->setImage(_priority, image, duration);
+
+	// send reply with the image size that is sufficient for our led layout
+	const QSize imageSize = _hyperion->getLedImageSize();
+	proto::HyperionReply reply;
+	reply.set_type(proto::HyperionReply::REPLY);
+	reply.set_success(true);
+	reply.set_imagewidth(imageSize.width());
+	reply.set_imageheight(imageSize.height());
+	sendMessage(reply);
+}
+
+void ProtoClientConnection::handleSharedMemoryImageCommand(const proto::SharedMemoryImageRequest &message)
+{
+	// extract parameters
+	_priority = message.priority();
+	int duration = message.has_duration() ? message.duration() : -1;
+	int width = message.imagewidth();
+	int height = message.imageheight();
+	const QString key = QString::fromStdString(message.key());
+
+	// shared memory is only passed by local clients, which name their own image rings. Other keys
+	// would publish arbitrary segments of this host.
+	if (!_socket->peerAddress().isLoopback())
+	{
+		sendErrorReply("Shared memory images are only accepted from the local host", true);
+		return;
+	}
+	if (!QRegExp(QString(ImageEncoding::SHARED_MEMORY_KEY_PREFIX) + "[0-9]+-[0-9]+").exactMatch(key))
+	{
+		sendErrorReply("Invalid shared memory key", true);
+		return;
+	}
+
+	// the size is limited, so the slot bounds below cannot overflow
+	if (width <= 0 || height <= 0 || width > ImageEncoding::MAX_IMAGE_DIMENSION || height > ImageEncoding::MAX_IMAGE_DIMENSION || message.slot() < 0)
+	{
+		sendErrorReply("Invalid image size or shared memory slot", true);
+		return;
+	}
+
+	// attach to the image ring of the client (a new key is used whenever the client recreates it)
+	if (_sharedMemory.key() != key || !_sharedMemory.isAttached())
+	{
+		if (_sharedMemory.isAttached())
+		{
+			_sharedMemory.detach();
+		}
+		_sharedMemory.setKey(key);
+		if (!_sharedMemory.attach(QSharedMemory::ReadOnly))
+		{
+			sendErrorReply("Unable to attach shared memory: " + _sharedMemory.errorString().toStdString(), true);
+			return;
+		}
+	}
+
+	// check that the slot lies within the ring
+	const qint64 slotSize = qint64(width) * height * 3;
+	if ((qint64(message.slot()) + 1) * slotSize > qint64(_sharedMemory.size()))
+	{
+		sendErrorReply("Shared memory slot does not match with the width and height", true);
+		return;
+	}
+
+	// copy the slot into the reused image, the client overwrites the slot with a later frame
+	_sharedMemoryImage.resize(width, height);
+	_sharedMemory.lock();
+	memcpy(_sharedMemoryImage.memptr(), static_cast<const uint8_t *>(_sharedMemory.constData()) + message.slot() * slotSize, size_t(slotSize));
+	_sharedMemory.unlock();
+	const Image<ColorRgb> & image = _sharedMemoryImage;
+
+	// set width and height of the image processor
+	_imageProcessor->setSize(width, height);
 
 	// process the image
 	std::vector<ColorRgb> ledColors = _imageProcessor->process(image);
 	_hyperion->setColors(_priority, ledColors, duration);
 	_hyperion->setImage(_priority, image, duration);
+	emit newImage(_priority, image, duration);
 
 	// send reply
 	sendSuccessReply();
 }
 
+void ProtoClientConnection::handleLedColorsCommand(const proto::LedColorsRequest &message)
+{
+	// extract parameters
+	_priority = message.priority();
+	int duration = message.has_duration() ? message.duration() : -1;
+	const std::string & ledData = message.ledcolors();
+
+	// check that the colors have been computed for our led layout
+	if (message.has_layouthash() && message.layouthash() != _hyperion->getLedLayoutHash().toStdString())
+	{
+		sendErrorReply("Led layout of the client does not match the led layout of the server");
+		return;
+	}
+
+	// check consistency of the size of the received data
+	if (ledData.size() != _hyperion->getLedCount() * 3)
+	{
+		sendErrorReply("Size of led data does not match with the number of leds");
+		return;
+	}
+
+	// the colors are already mapped, so skip the image processor
+	std::vector<ColorRgb> ledColors(_hyperion->getLedCount());
+	memcpy(ledColors.data(), ledData.data(), ledData.size());
+	_hyperion->setColors(_priority, ledColors, duration);
+
+	// send reply
+	sendSuccessReply();
+}
 
 void ProtoClientConnection::handleClearCommand(const proto::ClearRequest &message)
 {
@@ -254,13 +399,17 @@ void ProtoClientConnection::sendSuccessReply()
 	sendMessage(reply);
 }
 
-void ProtoClientConnection::sendErrorReply(const std::string &error)
+void ProtoClientConnection::sendErrorReply(const std::string &error, bool sharedMemoryRejected)
 {
 	// create reply
 	proto::HyperionReply reply;
 	reply.set_type(proto::HyperionReply::REPLY);
 	reply.set_success(false);
 	reply.set_error(error);
+	if (sharedMemoryRejected)
+	{
+		reply.set_sharedmemoryrejected(true);
+	}
 
 	// send reply
 	sendMessage(reply);
@@ -7,6 +7,7 @@
 #include <QByteArray>
 #include <QTcpSocket>
 #include <QStringList>
+#include <QSharedMemory>
 
 // Hyperion includes
 #include <hyperion/Hyperion.h>
@@ -56,6 +57,11 @@ signals:
 	void connectionClosed(ProtoClientConnection * connection);
 	void newMessage(const proto::HyperionRequest * message);
 
+	///
+	/// Signal which is emitted for images which can't be forwarded as message (shared memory images)
+	///
+	void newImage(int priority, const Image<ColorRgb> & image, int duration_ms);
+
 private slots:
 	///
 	/// Slot called when new data has arrived
@@ -89,6 +95,20 @@ private:
 	///
 	void handleImageCommand(const proto::ImageRequest & message);
 
+	///
+	/// Handle an incoming Proto SharedMemoryImage message
+	///
+	/// @param message the incoming message
+	///
+	void handleSharedMemoryImageCommand(const proto::SharedMemoryImageRequest & message);
+
+	///
+	/// Handle an incoming Proto LedColors message
+	///
+	/// @param message the incoming message
+	///
+	void handleLedColorsCommand(const proto::LedColorsRequest & message);
+
 	///
 	/// Handle an incoming Proto Clear message
 	///
@@ -122,8 +142,9 @@ private:
 	/// Send an error message back to the client
 	///
 	/// @param error String describing the error
+	/// @param sharedMemoryRejected Set if a shared memory image failed (the client falls back to the socket)
 	///
-	void sendErrorReply(const std::string & error);
+	void sendErrorReply(const std::string & error, bool sharedMemoryRejected = false);
 
 private:
 	/// The TCP-Socket that is connected tot the Proto-client
@@ -137,6 +158,12 @@ private:
 
 	/// The buffer used for reading data from the socket
 	QByteArray _receiveBuffer;
+
+	/// The image ring of a local client
+	QSharedMemory _sharedMemory;
+
+	/// The image the shared memory images are copied into, reused for every frame
+	Image<ColorRgb> _sharedMemoryImage;
 	
 	int _priority;
 	
@@ -3,15 +3,33 @@
 
 // Qt includes
 #include <QRgb>
+#include <QCoreApplication>
+#include <QHostAddress>
+
+// hyperion includes
+#include <hyperion/ImageProcessorFactory.h>
+#include <hyperion/ImageProcessor.h>
 
 // protoserver includes
 #include "protoserver/ProtoConnection.h"
+#include "ImageEncoding.h"
 
 ProtoConnection::ProtoConnection(const std::string & a) :
 	_socket(),
 	_skipReply(false),
+	_imageCompression(false),
+	_imageSize(),
+	_scaledImage(),
+	_useSharedMemory(false),
+	_sharedMemory(),
+	_sharedMemoryGeneration(0),
+	_sharedMemorySlot(0),
+	_sharedMemoryImageSize(),
+	_sharedMemoryPriority(0),
+	_sharedMemoryDuration(-1),
 	_prevSocketState(QAbstractSocket::UnconnectedState),
-	_log(Logger::getInstance("PROTOCONNECTION"))
+	_log(Logger::getInstance("PROTOCONNECTION")),
+	_imageProcessor(nullptr)
 	{
 	QString address(a.c_str());
 	QStringList parts = address.split(":");
@@ -45,6 +63,7 @@ ProtoConnection::~ProtoConnection()
 {
 	_timer.stop();
 	_socket.close();
+	delete _imageProcessor;
 }
 
 void ProtoConnection::readData()
@@ -90,6 +109,28 @@ void ProtoConnection::setSkipReply(bool skip)
 	_skipReply = skip;
 }
 
+void ProtoConnection::setImageCompression(bool compress)
+{
+	_imageCompression = compress;
+}
+
+bool ProtoConnection::setSharedMemory(bool enable)
+{
+	if (enable && _host != "localhost" && !QHostAddress(_host).isLoopback())
+	{
+		Warning(_log, "Shared memory transport requires a local Hyperion server, using the socket");
+		enable = false;
+	}
+
+	_useSharedMemory = enable;
+	if (!_useSharedMemory && _sharedMemory.isAttached())
+	{
+		_sharedMemory.detach();
+	}
+
+	return _useSharedMemory;
+}
+
 void ProtoConnection::setColor(const ColorRgb & color, int priority, int duration)
 {
 	proto::HyperionRequest request;
@@ -105,12 +146,46 @@ void ProtoConnection::setColor(const ColorRgb & color, int priority, int duratio
 
 void ProtoConnection::setImage(const Image<ColorRgb> &image, int priority, int duration)
 {
+	if (_imageProcessor != nullptr)
+	{
+		_imageProcessor->process(image, _ledColors);
+		setLedColors(_ledColors, priority, duration);
+		return;
+	}
+
+	// downscale the image if the server does not need the full size
+	const Image<ColorRgb> * sendImage = &image;
+	if (!_imageSize.isEmpty())
+	{
+		const unsigned factor = std::min(image.width() / _imageSize.width(), image.height() / _imageSize.height());
+		if (factor > 1)
+		{
+			ImageEncoding::downscale(image, factor, _scaledImage);
+			sendImage = &_scaledImage;
+		}
+	}
+
+	if (_useSharedMemory)
+	{
+		setImageSharedMemory(*sendImage, priority, duration);
+		return;
+	}
+
 	proto::HyperionRequest request;
 	request.set_command(proto::HyperionRequest::IMAGE);
 	proto::ImageRequest * imageRequest = request.MutableExtension(proto::ImageRequest::imageRequest);
-	imageRequest->set_imagedata(image.memptr(), image.width() * image.height() * 3);
-	imageRequest->set_imagewidth(image.width());
-	imageRequest->set_imageheight(image.height());
+	if (_imageCompression)
+	{
+		const QByteArray imageData = ImageEncoding::encodeRowDelta(*sendImage);
+		imageRequest->set_imagedata(imageData.constData(), imageData.size());
+		imageRequest->set_encoding(proto::ImageRequest::ROWDELTA_ZLIB);
+	}
+	else
+	{
+		imageRequest->set_imagedata(sendImage->memptr(), sendImage->width() * sendImage->height() * 3);
+	}
+	imageRequest->set_imagewidth(sendImage->width());
+	imageRequest->set_imageheight(sendImage->height());
 	imageRequest->set_priority(priority);
 	imageRequest->set_duration(duration);
 
@@ -118,6 +193,116 @@ void ProtoConnection::setImage(const Image<ColorRgb> &image, int priority, int d
 	sendMessage(request);
 }
 
+void ProtoConnection::setImageSharedMemory(const Image<ColorRgb> & image, int priority, int duration)
+{
+	const int slotSize = image.width() * image.height() * 3;
+
+	// only touch the shared memory if the server can pick the image up
+	if (_socket.state() == QAbstractSocket::ConnectedState)
+	{
+		// (re)create the ring if the image size changed
+		if (!_sharedMemory.isAttached() || _sharedMemory.size() < slotSize * SHARED_MEMORY_SLOTS)
+		{
+			if (_sharedMemory.isAttached())
+			{
+				_sharedMemory.detach();
+			}
+
+			_sharedMemory.setKey(QString("%1%2-%3").arg(ImageEncoding::SHARED_MEMORY_KEY_PREFIX).arg(QCoreApplication::applicationPid()).arg(++_sharedMemoryGeneration));
+			if (!_sharedMemory.create(slotSize * SHARED_MEMORY_SLOTS))
+			{
+				Error(_log, "Unable to create shared memory (%s), using the socket", _sharedMemory.errorString().toStdString().c_str());
+				_useSharedMemory = false;
+				setImage(image, priority, duration);
+				return;
+			}
+			_sharedMemorySlot = 0;
+		}
+
+		// copy the image into the next slot
+		_sharedMemory.lock();
+		memcpy(static_cast<uint8_t *>(_sharedMemory.data()) + _sharedMemorySlot * slotSize, image.memptr(), slotSize);
+		_sharedMemory.unlock();
+
+		_sharedMemoryImageSize = QSize(image.width(), image.height());
+		_sharedMemoryPriority = priority;
+		_sharedMemoryDuration = duration;
+	}
+
+	proto::HyperionRequest request;
+	request.set_command(proto::HyperionRequest::SHMIMAGE);
+	proto::SharedMemoryImageRequest * shmRequest = request.MutableExtension(proto::SharedMemoryImageRequest::sharedMemoryImageRequest);
+	shmRequest->set_key(_sharedMemory.key().toStdString());
+	shmRequest->set_slot(_sharedMemorySlot);
+	shmRequest->set_imagewidth(image.width());
+	shmRequest->set_imageheight(image.height());
+	shmRequest->set_priority(priority);
+	shmRequest->set_duration(duration);
+
+	_sharedMemorySlot = (_sharedMemorySlot + 1) % SHARED_MEMORY_SLOTS;
+
+	// send command message
+	sendMessage(request);
+}
+
+void ProtoConnection::sharedMemoryRejected(const std::string & error)
+{
+	// images sent before the switch to the socket are rejected as well
+	if (!_useSharedMemory)
+	{
+		return;
+	}
+	Warning(_log, "Hyperion rejected the shared memory image (%s), using the socket", error.c_str());
+
+	// the last image is still in the ring, its slot is the one before the next slot
+	Image<ColorRgb> image;
+	const bool resend = _sharedMemory.isAttached() && !_sharedMemoryImageSize.isEmpty();
+	if (resend)
+	{
+		const int slotSize = _sharedMemoryImageSize.width() * _sharedMemoryImageSize.height() * 3;
+		const int slot = (_sharedMemorySlot + SHARED_MEMORY_SLOTS - 1) % SHARED_MEMORY_SLOTS;
+		image.resize(_sharedMemoryImageSize.width(), _sharedMemoryImageSize.height());
+		_sharedMemory.lock();
+		memcpy(image.memptr(), static_cast<const uint8_t *>(_sharedMemory.constData()) + slot * slotSize, slotSize);
+		_sharedMemory.unlock();
+	}
+
+	setSharedMemory(false);
+	if (resend)
+	{
+		setImage(image, _sharedMemoryPriority, _sharedMemoryDuration);
+	}
+}
+
+void ProtoConnection::setLedColors(const std::vector<ColorRgb> & ledColors, int priority, int duration)
+{
+	proto::HyperionRequest request;
+	request.set_command(proto::HyperionRequest::LEDCOLORS);
+	proto::LedColorsRequest * ledColorsRequest = request.MutableExtension(proto::LedColorsRequest::ledColorsRequest);
+	ledColorsRequest->set_ledcolors(ledColors.data(), ledColors.size() * 3);
+	ledColorsRequest->set_priority(priority);
+	ledColorsRequest->set_duration(duration);
+	if (!_ledLayoutHash.isEmpty())
+	{
+		ledColorsRequest->set_layouthash(_ledLayoutHash.constData(), _ledLayoutHash.size());
+	}
+
+	// send command message
+	sendMessage(request);
+}
+
+void ProtoConnection::setLedLayout(const LedString & ledString, const QJsonObject & blackborderConfig, int mappingType)
+{
+	delete _imageProcessor;
+
+	ImageProcessorFactory::getInstance().init(ledString, blackborderConfig, mappingType);
+	_imageProcessor = ImageProcessorFactory::getInstance().newImageProcessor();
+	_ledLayoutHash = ledString.layoutHash();
+	_ledColors.assign(ledString.leds().size(), ColorRgb::BLACK);
+
+	Info(_log, "Client side led mapping enabled for %d leds", int(ledString.leds().size()));
+}
+
 void ProtoConnection::clear(int priority)
 {
 	proto::HyperionRequest request;
@@ -207,6 +392,18 @@ bool ProtoConnection::parseReply(const proto::HyperionReply &reply)
 	{
 		case proto::HyperionReply::REPLY:
 		{
+			// a failed shared memory image is sent through the socket instead of ending the client
+			if (!reply.success() && reply.sharedmemoryrejected())
+			{
+				sharedMemoryRejected(reply.error());
+				break;
+			}
+
+			if (reply.has_imagewidth() && reply.has_imageheight())
+			{
+				_imageSize = QSize(reply.imagewidth(), reply.imageheight());
+			}
+
 			if (!_skipReply)
 			{
 				if (!reply.success())
@@ -1,3 +1,8 @@
+// hyperion includes
+#include <hyperion/Hyperion.h>
+#include <hyperion/ImageProcessor.h>
+#include <utils/jsonschema/QJsonFactory.h>
+
 // protoserver includes
 #include "protoserver/ProtoConnectionWrapper.h"
 
@@ -18,6 +23,25 @@ ProtoConnectionWrapper::~ProtoConnectionWrapper()
 {
 }
 
+void ProtoConnectionWrapper::setLedLayout(const QString & configFile)
+{
+	const QJsonObject config = QJsonFactory::readConfig(configFile);
+	const LedString ledString = Hyperion::createLedString(config["leds"], Hyperion::createColorOrder(config["device"].toObject()));
+	const int mappingType = ImageProcessor::mappingTypeToInt(config["color"].toObject()["imageToLedMappingType"].toString());
+
+	_connection.setLedLayout(ledString, config["blackborderdetector"].toObject(), mappingType);
+}
+
+void ProtoConnectionWrapper::setImageCompression(bool compress)
+{
+	_connection.setImageCompression(compress);
+}
+
+void ProtoConnectionWrapper::setSharedMemory(bool enable)
+{
+	_connection.setSharedMemory(enable);
+}
+
 void ProtoConnectionWrapper::receiveImage(const Image<ColorRgb> & image)
 {
 	_connection.setImage(image, _priority, _duration_ms);
@@ -68,6 +68,7 @@ void ProtoServer::newConnection()
 		// register slot for cleaning up after the connection closed
 		connect(connection, SIGNAL(connectionClosed(ProtoClientConnection*)), this, SLOT(closedConnection(ProtoClientConnection*)));
 		connect(connection, SIGNAL(newMessage(const proto::HyperionRequest*)), this, SLOT(newMessage(const proto::HyperionRequest*)));
+		connect(connection, SIGNAL(newImage(int, const Image<ColorRgb>&, int)), this, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, int)));
 		
 		// register forward signal for kodi checker
 		connect(this, SIGNAL(grabbingMode(GrabbingMode)), connection, SLOT(setGrabbingMode(GrabbingMode)));
@@ -78,6 +79,12 @@ void ProtoServer::newConnection()
 
 void ProtoServer::newMessage(const proto::HyperionRequest * message)
 {
+	// shared memory is local to this host, these images are forwarded by sendImageToProtoSlaves
+	if (message->command() == proto::HyperionRequest::SHMIMAGE)
+	{
+		return;
+	}
+
 	for (int i = 0; i < _proxy_connections.size(); ++i)
 		_proxy_connections.at(i)->sendMessage(*message);
 }
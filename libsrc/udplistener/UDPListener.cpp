@@ -1,6 +1,9 @@
 // system includes
 #include <stdexcept>
 
+// Qt includes
+#include <QtEndian>
+
 // project includes
 #include <udplistener/UDPListener.h>
 
@@ -12,7 +15,8 @@
 
 using namespace hyperion;
 
-UDPListener::UDPListener(const int priority, const int timeout, const QString& address, quint16 listenPort, bool shared) :
+UDPListener::UDPListener(const int priority, const int timeout, const QString& address, quint16 listenPort, bool shared,
+	const QString& protocol, const int universe, const int syncUniverse, const int channelsPerUniverse) :
 	QObject(),
 	_hyperion(Hyperion::getInstance()),
 	_server(),
@@ -22,11 +26,38 @@ UDPListener::UDPListener(const int priority, const int timeout, const QString& a
 	_log(Logger::getInstance("UDPLISTENER")),
 	_isActive(false),
 	_listenPort(listenPort),
-	_bondage(shared ? QAbstractSocket::ShareAddress : QAbstractSocket::DefaultForPlatform)
+	_bondage(shared ? QAbstractSocket::ShareAddress : QAbstractSocket::DefaultForPlatform),
+	_datagram(),
+	_ledColors(_hyperion->getLedCount(), ColorRgb::BLACK),
+	_protocol(protocol == "e131" ? E131 : protocol == "artnet" ? ARTNET : RAW),
+	_universe((_protocol == E131) ? std::max(1, universe) : universe),
+	_syncUniverse(syncUniverse),
+	_channelsPerUniverse(std::max(3, std::min(channelsPerUniverse, DMX_MAX))),
+	_universeCount((_ledColors.size() * 3 + _channelsPerUniverse - 1) / _channelsPerUniverse),
+	_universeReceived(_universeCount, false),
+	_universesPending(_universeCount),
+	_universeSequence(_universeCount, -1)
 {
 	_server = new QUdpSocket(this);
 	_listenAddress = address.isEmpty()? QHostAddress::AnyIPv4 : QHostAddress(address);
 
+	// a socket bound to a multicast group (e.g. the default group of raw mode) receives only that group,
+	// E1.31 joins the group of every universe instead and Art-Net does not use multicast
+	if (_protocol != RAW && _listenAddress.isInSubnet(QHostAddress::parseSubnet("224.0.0.0/4")))
+	{
+		Info(_log, "Multicast address %s is not used by %s, listening on all addresses", _listenAddress.toString().toStdString().c_str(),
+			_protocol == E131 ? "E1.31" : "Art-Net");
+		_listenAddress = QHostAddress::AnyIPv4;
+	}
+
+	if (_protocol != RAW)
+	{
+		WarningIf(_protocol == E131 && universe < 1, _log, "E1.31 universes start at 1, using universe 1 instead of %d", universe);
+		Info(_log, "%s receiver for universes %d-%d (%d channels per universe), %s", _protocol == E131 ? "E1.31" : "Art-Net",
+			_universe, _universe + _universeCount - 1, _channelsPerUniverse,
+			_syncUniverse > 0 ? QString("synchronized by universe %1").arg(_syncUniverse).toStdString().c_str() : "unsynchronized");
+	}
+
 	// Set trigger for incoming connections
 	connect(_server, SIGNAL(readyRead()), this, SLOT(readPendingDatagrams()));
 
@@ -64,6 +95,25 @@ void UDPListener::start()
 			InfoIf   (   joinGroupOK, _log, "Multicast enabled");
 			WarningIf( ! joinGroupOK, _log, "Multicast failed");
 		}
+		else if (_protocol == E131 && _listenAddress == QHostAddress(QHostAddress::AnyIPv4))
+		{
+			// sACN sends every universe to its own multicast group 239.255.<universe hi>.<universe lo>
+			QList<int> universes;
+			for (int universe = _universe; universe < _universe + _universeCount; ++universe)
+			{
+				universes << universe;
+			}
+			if (_syncUniverse > 0 && !universes.contains(_syncUniverse))
+			{
+				universes << _syncUniverse;
+			}
+
+			for (const int universe : universes)
+			{
+				const QHostAddress group(QString("239.255.%1.%2").arg((universe >> 8) & 0xff).arg(universe & 0xff));
+				WarningIf( ! _server->joinMulticastGroup(group), _log, "Multicast join of %s failed", group.toString().toStdString().c_str());
+			}
+		}
 		_isActive = true;
 		emit statusChanged(_isActive);
 	}
@@ -101,35 +151,168 @@ uint16_t UDPListener::getPort() const
 
 void UDPListener::readPendingDatagrams()
 {
-	while (_server->hasPendingDatagrams()) {
-		QByteArray datagram;
-		datagram.resize(_server->pendingDatagramSize());
-		QHostAddress sender;
-		quint16 senderPort;
+	// drain the socket, every datagram is a complete frame so only the newest one is of interest
+	qint64 size = -1;
+	while (_server->hasPendingDatagrams())
+	{
+		const qint64 pendingSize = _server->pendingDatagramSize();
+		if (pendingSize > _datagram.size())
+		{
+			_datagram.resize(pendingSize);
+		}
 
-		_server->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+		const qint64 readSize = _server->readDatagram(_datagram.data(), _datagram.size());
+		if (readSize <= 0)
+		{
+			continue;
+		}
 
-		processTheDatagram(&datagram);
+		// universes of a frame arrive in separate datagrams, each of them is needed
+		switch (_protocol)
+		{
+			case E131:   processE131Datagram(reinterpret_cast<const uint8_t *>(_datagram.constData()), readSize); break;
+			case ARTNET: processArtNetDatagram(reinterpret_cast<const uint8_t *>(_datagram.constData()), readSize); break;
+			default:     size = readSize;
+		}
+	}
 
+	if (size > 0)
+	{
+		processTheDatagram(_datagram, size);
 	}
 }
 
 
-void UDPListener::processTheDatagram(const QByteArray * datagram)
+void UDPListener::processTheDatagram(const QByteArray & datagram, const qint64 size)
 {
-	int packetLedCount = datagram->size()/3;
-	int hyperionLedCount = Hyperion::getInstance()->getLedCount();
+	const int packetLedCount = size/3;
+	const int hyperionLedCount = _ledColors.size();
 	DebugIf( (packetLedCount != hyperionLedCount), _log, "packetLedCount (%d) != hyperionLedCount (%d)", packetLedCount, hyperionLedCount);
 
-        std::vector<ColorRgb> _ledColors(Hyperion::getInstance()->getLedCount(), ColorRgb::BLACK);
+	// ColorRgb is packed rgb, so the datagram can be copied as it is
+	const int ledCount = std::min(packetLedCount, hyperionLedCount);
+	memcpy(_ledColors.data(), datagram.constData(), ledCount * sizeof(ColorRgb));
+	std::fill(_ledColors.begin() + ledCount, _ledColors.end(), ColorRgb::BLACK);
+
+	// the muxer copies into its existing channel buffer, so no allocation happens per frame
+	_hyperion->setColors(_priority, _ledColors, _timeout, -1, hyperion::COMP_UDPLISTENER);
+}
+
+void UDPListener::processE131Datagram(const uint8_t * data, const qint64 size)
+{
+	static const uint8_t acnId[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
+	if (size < E131_SYNC_SIZE || memcmp(data + E131_ROOT_ID, acnId, sizeof(acnId)) != 0)
+	{
+		return;
+	}
+
+	const quint32 rootVector  = qFromBigEndian<quint32>(data + E131_ROOT_VECTOR);
+	const quint32 frameVector = qFromBigEndian<quint32>(data + E131_FRAME_VECTOR);
+
+	if (rootVector == VECTOR_ROOT_E131_EXTENDED && frameVector == VECTOR_E131_EXTENDED_SYNCHRONIZATION)
+	{
+		if (_syncUniverse > 0 && qFromBigEndian<quint16>(data + E131_SYNC_ADDRESS) == _syncUniverse)
+		{
+			commitFrame();
+		}
+		return;
+	}
+
+	if (rootVector != VECTOR_ROOT_E131_DATA || frameVector != VECTOR_E131_DATA_PACKET || size <= E131_DMP_DATA)
+	{
+		return;
+	}
+
+	// skip preview data and stream termination, only null start code carries led data
+	const uint8_t options = data[E131_FRAME_OPT];
+	if ((options & 0xc0) != 0 || data[E131_DMP_DATA] != 0)
+	{
+		return;
+	}
+
+	const int universe = qFromBigEndian<quint16>(data + E131_FRAME_UNIVERSE);
+	const int syncAddress = qFromBigEndian<quint16>(data + E131_FRAME_SYNC_ADDRESS);
+	const int count = std::min<int>(qFromBigEndian<quint16>(data + E131_DMP_COUNT), size - E131_DMP_DATA) - 1;
+
+	processUniverse(universe, data[E131_FRAME_SEQ], data + E131_DMP_DATA + 1, count, _syncUniverse > 0 && syncAddress == _syncUniverse);
+}
+
+void UDPListener::processArtNetDatagram(const uint8_t * data, const qint64 size)
+{
+	if (size < ARTNET_DMX_DATA || memcmp(data, ARTNET_ID, sizeof(ARTNET_ID)) != 0)
+	{
+		return;
+	}
+
+	const quint16 opcode = qFromLittleEndian<quint16>(data + ARTNET_OPCODE);
+	if (opcode == ARTNET_OP_SYNC)
+	{
+		if (_syncUniverse > 0)
+		{
+			commitFrame();
+		}
+		return;
+	}
+
+	if (opcode != ARTNET_OP_DMX)
+	{
+		return;
+	}
+
+	const int universe = (data[ARTNET_DMX_NET] << 8) | data[ARTNET_DMX_SUBUNI];
+	const int count = std::min<int>(qFromBigEndian<quint16>(data + ARTNET_DMX_LENGTH), size - ARTNET_DMX_DATA);
+
+	processUniverse(universe, data[ARTNET_DMX_SEQ], data + ARTNET_DMX_DATA, count, _syncUniverse > 0);
+}
+
+void UDPListener::processUniverse(const int universe, const uint8_t sequence, const uint8_t * data, int count, const bool synchronized)
+{
+	const int index = universe - _universe;
+	if (index < 0 || index >= _universeCount || count <= 0)
+	{
+		return;
+	}
+
+	// discard packets which arrive out of order (E1.31 6.7.2), sequence 0 disables the check for Art-Net
+	if (sequence != 0 && _universeSequence[index] >= 0)
+	{
+		const int8_t diff = int8_t(sequence - uint8_t(_universeSequence[index]));
+		if (diff <= 0 && diff > -20)
+		{
+			return;
+		}
+	}
+	_universeSequence[index] = sequence;
+
+	// copy the channels of the universe into its part of the frame
+	uint8_t * frame = reinterpret_cast<uint8_t *>(_ledColors.data());
+	const int frameSize = _ledColors.size() * 3;
+	const int offset = index * _channelsPerUniverse;
+	count = std::min(count, std::min(_channelsPerUniverse, frameSize - offset));
+	memcpy(frame + offset, data, count);
 
-	for (int ledIndex=0; ledIndex < std::min(packetLedCount, hyperionLedCount);  ledIndex++) {
-		ColorRgb & rgb =  _ledColors[ledIndex];
-		rgb.red = datagram->at(ledIndex*3+0);
-		rgb.green = datagram->at(ledIndex*3+1);
-		rgb.blue = datagram->at(ledIndex*3+2);
+	if (!_universeReceived[index])
+	{
+		_universeReceived[index] = true;
+		--_universesPending;
+	}
+
+	// without synchronization the frame is complete as soon as every universe arrived
+	if (!synchronized && _universesPending == 0)
+	{
+		commitFrame();
+	}
+}
+
+void UDPListener::commitFrame()
+{
+	if (_universesPending == _universeCount)
+	{
+		return;
 	}
 
 	_hyperion->setColors(_priority, _ledColors, _timeout, -1, hyperion::COMP_UDPLISTENER);
 
+	std::fill(_universeReceived.begin(), _universeReceived.end(), false);
+	_universesPending = _universeCount;
 }
@@ -1,3 +1,7 @@
+// STL includes
+#include <algorithm>
+#include <vector>
+
 #include "utils/ImageResampler.h"
 #include <utils/Logger.h>
 
@@ -9,6 +13,7 @@ ImageResampler::ImageResampler()
 	, _cropTop(0)
 	, _cropBottom(0)
 	, _videoMode(VIDEO_2D)
+	, _averaging(false)
 {
 
 }
@@ -41,8 +46,18 @@ void ImageResampler::set3D(VideoMode mode)
 	_videoMode = mode;
 }
 
-void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
+void ImageResampler::setAveraging(bool enable)
 {
+	_averaging = enable;
+}
+
+void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage, int chromaOffset) const
+{
+	if (chromaOffset <= 0)
+	{
+		chromaOffset = lineLength * height;
+	}
+
 	int cropLeft = _cropLeft;
 	int cropRight = _cropRight;
 	int cropTop = _cropTop;
@@ -64,14 +79,50 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 	// calculate the output size
 	int outputWidth = (width - cropLeft - cropRight - _horizontalDecimation/2 + _horizontalDecimation - 1) / _horizontalDecimation;
 	int outputHeight = (height - cropTop - cropBottom - _verticalDecimation/2 + _verticalDecimation - 1) / _verticalDecimation;
-	if ((outputImage.height() != unsigned(outputHeight)) && (outputImage.width() != unsigned(outputWidth)))
+	if ((outputImage.height() != unsigned(outputHeight)) || (outputImage.width() != unsigned(outputWidth)))
 		outputImage.resize(outputWidth, outputHeight);
 
+	if (_averaging && pixelFormat != PIXELFORMAT_MJPEG && pixelFormat != PIXELFORMAT_NO_CHANGE)
+	{
+		averageImage(data, width, height, lineLength, chromaOffset, pixelFormat, cropLeft, cropRight, cropTop, cropBottom, outputImage);
+		return;
+	}
+
+	if (pixelFormat == PIXELFORMAT_NV12 || pixelFormat == PIXELFORMAT_I420)
+	{
+		// planar formats, only the luma and chroma rows of the sampled pixels are read
+		// the luma plane may be padded below the image, the chroma planes start at chromaOffset
+		const uint8_t * chromaPlane = data + chromaOffset;
+		const int chromaLineLength = (pixelFormat == PIXELFORMAT_NV12) ? lineLength : lineLength/2;
+		const int chromaStep = (pixelFormat == PIXELFORMAT_NV12) ? 2 : 1;
+		const int vOffset = (pixelFormat == PIXELFORMAT_NV12) ? 1 : chromaLineLength * ((chromaOffset/lineLength + 1)/2);
+
+		// the pixels are detached once, not per output pixel
+		ColorRgb * output = outputImage.memptr();
+		for (int yDest = 0, ySource = cropTop + _verticalDecimation/2; yDest < outputHeight; ySource += _verticalDecimation, ++yDest)
+		{
+			const uint8_t * yRow = data + lineLength * ySource;
+			const uint8_t * uRow = chromaPlane + chromaLineLength * (ySource/2);
+			const uint8_t * vRow = uRow + vOffset;
+			ColorRgb * rgb = output + size_t(yDest) * outputWidth;
+
+			for (int xDest = 0, xSource = cropLeft + _horizontalDecimation/2; xDest < outputWidth; xSource += _horizontalDecimation, ++xDest)
+			{
+				const int chromaIndex = (xSource/2) * chromaStep;
+				yuv2rgb(yRow[xSource], uRow[chromaIndex], vRow[chromaIndex], rgb[xDest].red, rgb[xDest].green, rgb[xDest].blue);
+			}
+		}
+		return;
+	}
+
+	// the pixels are detached once, not per output pixel
+	ColorRgb * output = outputImage.memptr();
 	for (int yDest = 0, ySource = cropTop + _verticalDecimation/2; yDest < outputHeight; ySource += _verticalDecimation, ++yDest)
 	{
+		ColorRgb * outputRow = output + size_t(yDest) * outputWidth;
 	        for (int xDest = 0, xSource = cropLeft + _horizontalDecimation/2; xDest < outputWidth; xSource += _horizontalDecimation, ++xDest)
 		{
-			ColorRgb & rgb = outputImage(xDest, yDest);
+			ColorRgb & rgb = outputRow[xDest];
 			
 			switch (pixelFormat)
 			{
@@ -109,6 +160,14 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 					rgb.red   = data[index+2];
 				}
 				break;
+				case PIXELFORMAT_RGB24:
+				{
+					int index = lineLength * ySource + xSource * 3;
+					rgb.red   = data[index  ];
+					rgb.green = data[index+1];
+					rgb.blue  = data[index+2];
+				}
+				break;
 				case PIXELFORMAT_RGB32:
 				{
 					int index = lineLength * ySource + xSource * 4;
@@ -125,6 +184,9 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 					rgb.red   = data[index+2];
 				}
 				break;
+				case PIXELFORMAT_NV12:
+				case PIXELFORMAT_I420:
+				case PIXELFORMAT_MJPEG:
 				case PIXELFORMAT_NO_CHANGE:
 					Error(Logger::getInstance("ImageResampler"), "Invalid pixel format given");
 				break;
@@ -133,6 +195,141 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 	}
 }
 
+void ImageResampler::averageImage(const uint8_t * data, int width, int height, int lineLength, int chromaOffset, PixelFormat pixelFormat,
+								  int cropLeft, int cropRight, int cropTop, int cropBottom, Image<ColorRgb> & outputImage) const
+{
+	const int outputWidth  = outputImage.width();
+	const int outputHeight = outputImage.height();
+	if (outputWidth <= 0 || outputHeight <= 0)
+	{
+		return;
+	}
+
+	// the last output pixels may have fewer source pixels
+	const int xEnd = width - cropRight;
+	const int yEnd = height - cropBottom;
+	const int rowLength = std::min(xEnd - cropLeft, outputWidth * _horizontalDecimation);
+
+	std::vector<ColorRgb> row(rowLength);
+	std::vector<uint32_t> sums(size_t(outputWidth) * 3);
+	ColorRgb * output = outputImage.memptr();
+
+	for (int yDest = 0; yDest < outputHeight; ++yDest)
+	{
+		const int yStart = cropTop + yDest * _verticalDecimation;
+		const int yStop  = std::min(yStart + _verticalDecimation, yEnd);
+		std::fill(sums.begin(), sums.end(), 0);
+
+		// convert every source row once and add it to the sums of the output row
+		for (int ySource = yStart; ySource < yStop; ++ySource)
+		{
+			convertRow(data, chromaOffset, lineLength, pixelFormat, ySource, cropLeft, rowLength, row.data());
+
+			uint32_t * sum = sums.data();
+			for (int xStart = 0; xStart < rowLength; xStart += _horizontalDecimation, sum += 3)
+			{
+				const int xStop = std::min(xStart + _horizontalDecimation, rowLength);
+				uint32_t red = 0, green = 0, blue = 0;
+				for (int x = xStart; x < xStop; ++x)
+				{
+					red   += row[x].red;
+					green += row[x].green;
+					blue  += row[x].blue;
+				}
+				sum[0] += red;
+				sum[1] += green;
+				sum[2] += blue;
+			}
+		}
+
+		ColorRgb * rgb = output + size_t(yDest) * outputWidth;
+		for (int xDest = 0; xDest < outputWidth; ++xDest)
+		{
+			const int xStart = xDest * _horizontalDecimation;
+			const uint32_t count = (yStop - yStart) * (std::min(xStart + _horizontalDecimation, rowLength) - xStart);
+			const uint32_t * sum = sums.data() + xDest * 3;
+			rgb[xDest].red   = uint8_t(sum[0] / count);
+			rgb[xDest].green = uint8_t(sum[1] / count);
+			rgb[xDest].blue  = uint8_t(sum[2] / count);
+		}
+	}
+}
+
+void ImageResampler::convertRow(const uint8_t * data, int chromaOffset, int lineLength, PixelFormat pixelFormat, int y, int xStart, int count, ColorRgb * row)
+{
+	const uint8_t * line = data + lineLength * y;
+	const int xStop = xStart + count;
+
+	switch (pixelFormat)
+	{
+		case PIXELFORMAT_UYVY:
+		case PIXELFORMAT_YUYV:
+		{
+			const int yIndex = (pixelFormat == PIXELFORMAT_UYVY) ? 1 : 0;
+			const int uIndex = (pixelFormat == PIXELFORMAT_UYVY) ? 0 : 1;
+			for (int x = xStart; x < xStop; ++x, ++row)
+			{
+				const uint8_t * pair = line + (x & ~1) * 2;
+				yuv2rgb(line[x * 2 + yIndex], pair[uIndex], pair[uIndex + 2], row->red, row->green, row->blue);
+			}
+		}
+		break;
+		case PIXELFORMAT_NV12:
+		case PIXELFORMAT_I420:
+		{
+			const uint8_t * chromaPlane = data + chromaOffset;
+			const int chromaLineLength = (pixelFormat == PIXELFORMAT_NV12) ? lineLength : lineLength/2;
+			const int chromaStep = (pixelFormat == PIXELFORMAT_NV12) ? 2 : 1;
+			const uint8_t * uRow = chromaPlane + chromaLineLength * (y/2);
+			const uint8_t * vRow = uRow + ((pixelFormat == PIXELFORMAT_NV12) ? 1 : chromaLineLength * ((chromaOffset/lineLength + 1)/2));
+			for (int x = xStart; x < xStop; ++x, ++row)
+			{
+				const int chromaIndex = (x/2) * chromaStep;
+				yuv2rgb(line[x], uRow[chromaIndex], vRow[chromaIndex], row->red, row->green, row->blue);
+			}
+		}
+		break;
+		case PIXELFORMAT_BGR16:
+			for (int x = xStart; x < xStop; ++x, ++row)
+			{
+				const uint8_t * pixel = line + x * 2;
+				row->blue  = (pixel[0] & 0x1f) << 3;
+				row->green = (((pixel[1] & 0x7) << 3) | (pixel[0] & 0xE0) >> 5) << 2;
+				row->red   = (pixel[1] & 0xF8);
+			}
+		break;
+		case PIXELFORMAT_BGR24:
+		case PIXELFORMAT_BGR32:
+		{
+			const int pixelSize = (pixelFormat == PIXELFORMAT_BGR24) ? 3 : 4;
+			for (int x = xStart; x < xStop; ++x, ++row)
+			{
+				const uint8_t * pixel = line + x * pixelSize;
+				row->blue  = pixel[0];
+				row->green = pixel[1];
+				row->red   = pixel[2];
+			}
+		}
+		break;
+		case PIXELFORMAT_RGB24:
+		case PIXELFORMAT_RGB32:
+		{
+			const int pixelSize = (pixelFormat == PIXELFORMAT_RGB24) ? 3 : 4;
+			for (int x = xStart; x < xStop; ++x, ++row)
+			{
+				const uint8_t * pixel = line + x * pixelSize;
+				row->red   = pixel[0];
+				row->green = pixel[1];
+				row->blue  = pixel[2];
+			}
+		}
+		break;
+		case PIXELFORMAT_MJPEG:
+		case PIXELFORMAT_NO_CHANGE:
+		break;
+	}
+}
+
 uint8_t ImageResampler::clamp(int x)
 {
 	return (x<0) ? 0 : ((x>255) ? 255 : uint8_t(x));
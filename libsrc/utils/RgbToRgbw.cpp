@@ -45,4 +45,43 @@ void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, const WhiteAlgorithm algori
 	}
 }
 
+void Rgb_to_Rgbw(const std::vector<ColorRgb> & input, std::vector<ColorRgbw> & output, const WhiteAlgorithm algorithm)
+{
+	output.resize(input.size());
+
+	// resolve the algorithm once per frame instead of once per led
+	switch (algorithm)
+	{
+		case SUBTRACT_MINIMUM:
+		{
+			for (size_t i = 0; i < input.size(); ++i)
+			{
+				const ColorRgb & color = input[i];
+				const uint8_t white = std::min(std::min(color.red, color.green), color.blue);
+				output[i] = { uint8_t(color.red - white), uint8_t(color.green - white), uint8_t(color.blue - white), white };
+			}
+			break;
+		}
+
+		case WHITE_OFF:
+		{
+			for (size_t i = 0; i < input.size(); ++i)
+			{
+				const ColorRgb & color = input[i];
+				output[i] = { color.red, color.green, color.blue, 0 };
+			}
+			break;
+		}
+
+		default:
+		{
+			for (size_t i = 0; i < input.size(); ++i)
+			{
+				Rgb_to_Rgbw(input[i], &output[i], algorithm);
+			}
+			break;
+		}
+	}
+}
+
 };
@@ -19,6 +19,11 @@ const Image<ColorRgb> & FramebufferWrapper::getScreenshot()
 	return _screenshot;
 }
 
+void FramebufferWrapper::setFileFormat(const unsigned xres, const unsigned yres, const unsigned bitsPerPixel)
+{
+	_grabber.setFileFormat(xres, yres, bitsPerPixel);
+}
+
 void FramebufferWrapper::start()
 {
 	_timer.start();
@@ -13,6 +13,11 @@ public:
 
 	const Image<ColorRgb> & getScreenshot();
 
+	///
+	/// Sets the format of a regular file grabbed instead of a framebuffer device
+	///
+	void setFileFormat(const unsigned xres, const unsigned yres, const unsigned bitsPerPixel);
+
 	///
 	/// Starts the timed capturing of screenshots
 	///
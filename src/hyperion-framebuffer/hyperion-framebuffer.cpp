@@ -32,9 +32,11 @@ int main(int argc, char ** argv)
 		IntOption     & argWidth      = parser.add<IntOption>    (0x0, "width",      "Width of the captured image [default: %1]", "160", 160, 4096);
 		IntOption     & argHeight     = parser.add<IntOption>    (0x0, "height",     "Height of the captured image [default: %1]", "160", 160, 4096);
 		BooleanOption & argScreenshot = parser.add<BooleanOption>(0x0, "screenshot",   "Take a single screenshot, save it to file and quit");
+		RegularExpressionOption & argFileFormat = parser.add<RegularExpressionOption>(0x0, "file-format", "Grab a regular file (e.g. a recorded framebuffer) given as device, with the format <width>x<height>x<bits per pixel>", "", QString("[0-9]+x[0-9]+x(16|24|32)"));
 		Option        & argAddress    = parser.add<Option>       ('a', "address",    "Set the address of the hyperion server [default: %1]", "127.0.0.1:19445");
 		IntOption     & argPriority   = parser.add<IntOption>    ('p', "priority",   "Use the provided priority channel (suggested 100-199) [default: %1]", "150");
 		BooleanOption & argSkipReply  = parser.add<BooleanOption>(0x0, "skip-reply", "Do not receive and check reply messages from Hyperion");
+		BooleanOption & argSharedMem  = parser.add<BooleanOption>(0x0, "shared-memory", "Pass the images through shared memory to a Hyperion server on this host");
 		BooleanOption & argHelp       = parser.add<BooleanOption>('h', "help",        "Show this help message and exit");
 
 		// parse all options
@@ -47,6 +49,11 @@ int main(int argc, char ** argv)
 		}
 
 		FramebufferWrapper fbWrapper(argDevice.getStdString(parser), argWidth.getInt(parser), argHeight.getInt(parser), 1000 / argFps.getInt(parser));
+		if (parser.isSet(argFileFormat))
+		{
+			const QStringList format = argFileFormat.value(parser).split('x');
+			fbWrapper.setFileFormat(format[0].toUInt(), format[1].toUInt(), format[2].toUInt());
+		}
 
 		if (parser.isSet(argScreenshot))
 		{
@@ -58,6 +65,7 @@ int main(int argc, char ** argv)
 		{
 			// Create the Proto-connection with hyperiond
 			ProtoConnectionWrapper protoWrapper(argAddress.value(parser), argPriority.getInt(parser), 1000, parser.isSet(argSkipReply));
+			protoWrapper.setSharedMemory(parser.isSet(argSharedMem));
 
 			// Connect the screen capturing to the proto processing
 			QObject::connect(&fbWrapper, SIGNAL(sig_screenshot(const Image<ColorRgb> &)), &protoWrapper, SLOT(receiveImage(Image<ColorRgb>)));
@@ -58,7 +58,7 @@ int main(int argc, char** argv)
 
 		Option             & argDevice              = parser.add<Option>       ('d', "device", "The device to use [default: %1]", "auto");
 		SwitchOption<VideoStandard> & argVideoStandard= parser.add<SwitchOption<VideoStandard>>('v', "video-standard", "The used video standard. Valid values are PAL, NTSC or no-change. [default: %1]", "no-change");
-		SwitchOption<PixelFormat> & argPixelFormat    = parser.add<SwitchOption<PixelFormat>>  (0x0, "pixel-format", "The use pixel format. Valid values are YUYV, UYVY, RGB32 or no-change. [default: %1]", "no-change");
+		SwitchOption<PixelFormat> & argPixelFormat    = parser.add<SwitchOption<PixelFormat>>  (0x0, "pixel-format", "The use pixel format. Valid values are YUYV, UYVY, NV12, I420, RGB32, MJPEG or no-change. [default: %1]", "no-change");
 		IntOption          & argInput               = parser.add<IntOption>    (0x0, "input", "Input channel (optional)", "-1");
 		IntOption          & argWidth               = parser.add<IntOption>    (0x0, "width", "Try to set the width of the video input [default: %1]", "-1");
 		IntOption          & argHeight              = parser.add<IntOption>    (0x0, "height", "Try to set the height of the video input [default: %1]", "-1");
@@ -87,6 +87,9 @@ int main(int argc, char** argv)
 		Option             & argAddress             = parser.add<Option>       ('a', "address", "Set the address of the hyperion server [default: %1]", "127.0.0.1:19445");
 		IntOption          & argPriority            = parser.add<IntOption>    ('p', "priority", "Use the provided priority channel (suggested 100-199) [default: %1]", "150");
 		BooleanOption      & argSkipReply           = parser.add<BooleanOption>(0x0, "skip-reply", "Do not receive and check reply messages from Hyperion");
+		Option             & argLedConfig           = parser.add<Option>       (0x0, "led-config", "Map the image to leds locally using the led layout of the given hyperion config file");
+		BooleanOption      & argCompress            = parser.add<BooleanOption>(0x0, "compress", "Send the images losslessly compressed to Hyperion");
+		BooleanOption      & argSharedMemory        = parser.add<BooleanOption>(0x0, "shared-memory", "Pass the images through shared memory to a Hyperion server on this host");
 		BooleanOption      & argHelp                = parser.add<BooleanOption>('h', "help", "Show this help message and exit");
 
 		argVideoStandard.addSwitch("pal", VIDEOSTANDARD_PAL);
@@ -95,7 +98,10 @@ int main(int argc, char** argv)
 
 		argPixelFormat.addSwitch("yuyv", PIXELFORMAT_YUYV);
 		argPixelFormat.addSwitch("uyvy", PIXELFORMAT_UYVY);
+		argPixelFormat.addSwitch("nv12", PIXELFORMAT_NV12);
+		argPixelFormat.addSwitch("i420", PIXELFORMAT_I420);
 		argPixelFormat.addSwitch("rgb32", PIXELFORMAT_RGB32);
+		argPixelFormat.addSwitch("mjpeg", PIXELFORMAT_MJPEG);
 		argPixelFormat.addSwitch("no-change", PIXELFORMAT_NO_CHANGE);
 
 		// parse all options
@@ -195,6 +201,12 @@ int main(int argc, char** argv)
 		else
 		{
 			ProtoConnectionWrapper protoWrapper(argAddress.value(parser), argPriority.getInt(parser), 1000, parser.isSet(argSkipReply));
+			if (parser.isSet(argLedConfig))
+			{
+				protoWrapper.setLedLayout(argLedConfig.value(parser));
+			}
+			protoWrapper.setImageCompression(parser.isSet(argCompress));
+			protoWrapper.setSharedMemory(parser.isSet(argSharedMemory));
 			QObject::connect(&grabber, SIGNAL(newFrame(Image<ColorRgb>)), &protoWrapper, SLOT(receiveImage(Image<ColorRgb>)));
 			if (grabber.start())
 				QCoreApplication::exec();
@@ -45,6 +45,9 @@ int main(int argc, char ** argv)
 		Option              & argAddress         = parser.add<Option>       ('a', "address", "Set the address of the hyperion server [default: %1]", "127.0.0.1:19445");
 		IntOption           & argPriority        = parser.add<IntOption>    ('p', "priority", "Use the provided priority channel (suggested 100-199) [default: %1]", "150");
 		BooleanOption       & argSkipReply       = parser.add<BooleanOption>(0x0, "skip-reply", "Do not receive and check reply messages from Hyperion");
+		Option              & argLedConfig       = parser.add<Option>       (0x0, "led-config", "Map the image to leds locally using the led layout of the given hyperion config file");
+		BooleanOption       & argCompress        = parser.add<BooleanOption>(0x0, "compress", "Send the images losslessly compressed to Hyperion");
+		BooleanOption       & argSharedMemory    = parser.add<BooleanOption>(0x0, "shared-memory", "Pass the images through shared memory to a Hyperion server on this host");
 		BooleanOption       & argHelp            = parser.add<BooleanOption>('h', "help", "Show this help message and exit");
 
 		// parse all options
@@ -80,6 +83,12 @@ int main(int argc, char ** argv)
 		{
 			// Create the Proto-connection with hyperiond
 			ProtoConnectionWrapper protoWrapper(argAddress.value(parser), argPriority.getInt(parser), 1000, parser.isSet(argSkipReply));
+			if (parser.isSet(argLedConfig))
+			{
+				protoWrapper.setLedLayout(argLedConfig.value(parser));
+			}
+			protoWrapper.setImageCompression(parser.isSet(argCompress));
+			protoWrapper.setSharedMemory(parser.isSet(argSharedMemory));
 
 			// Connect the screen capturing to the proto processing
 			QObject::connect(&x11Wrapper, SIGNAL(sig_screenshot(const Image<ColorRgb> &)), &protoWrapper, SLOT(receiveImage(Image<ColorRgb>)));
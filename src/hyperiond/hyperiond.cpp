@@ -50,6 +50,7 @@ HyperionDaemon::HyperionDaemon(QString configFile, QObject *parent)
 	, _fbGrabber(nullptr)
 	, _osxGrabber(nullptr)
 	, _hyperion(nullptr)
+	, _instances(nullptr)
 {
 	loadConfig(configFile, CURRENT_CONFIG_VERSION );
 
@@ -73,6 +74,7 @@ HyperionDaemon::HyperionDaemon(QString configFile, QObject *parent)
 	}
 	
 	_hyperion = Hyperion::initInstance(_qconfig, configFile);
+	_instances = new HyperionInstances(_qconfig, configFile);
 
 	Info(_log, "Hyperion initialized");
 }
@@ -94,6 +96,7 @@ void HyperionDaemon::freeObjects()
 	{
 		delete grabber;
 	}
+	delete _instances;
 	delete _kodiVideoChecker;
 	delete _jsonServer;
 	delete _protoServer;
@@ -101,6 +104,7 @@ void HyperionDaemon::freeObjects()
 	delete _udpListener;
 
 	_v4l2Grabbers.clear();
+	_instances      = nullptr;
 	_amlGrabber     = nullptr;
 	_dispmanx       = nullptr;
 	_fbGrabber      = nullptr;
@@ -349,12 +353,23 @@ void HyperionDaemon::startNetworkServices()
 	// Create UDP listener if configuration is present
 	bool udpListenerConfigured = _qconfig.contains("udpListener");
 	const QJsonObject & udpListenerConfig = _qconfig["udpListener"].toObject();
+	const QString udpListenerProtocol = udpListenerConfig["protocol"].toString("raw");
+	// an unset port or port 0 selects the standard port of the protocol
+	int udpListenerPort = udpListenerConfig["port"].toInt(0);
+	if (udpListenerPort <= 0)
+	{
+		udpListenerPort = udpListenerProtocol == "e131" ? E131_DEFAULT_PORT : udpListenerProtocol == "artnet" ? ARTNET_DEFAULT_PORT : 2801;
+	}
 	_udpListener = new UDPListener(
 				udpListenerConfig["priority"].toInt(700),
 				udpListenerConfig["timeout"].toInt(10000),
 				udpListenerConfig["address"].toString(""),
-				udpListenerConfig["port"].toInt(2801),
-				udpListenerConfig["shared"].toBool(false));
+				udpListenerPort,
+				udpListenerConfig["shared"].toBool(false),
+				udpListenerProtocol,
+				udpListenerConfig["universe"].toInt(1),
+				udpListenerConfig["syncUniverse"].toInt(0),
+				udpListenerConfig["channelsPerUniverse"].toInt(DMX_MAX));
 
 	Debug(_log, "UDP listener created");
 
@@ -409,6 +424,13 @@ void HyperionDaemon::createSystemFrameGrabber()
 		{
 			_grabber_width     = grabberConfig["width"].toInt(96);
 			_grabber_height    = grabberConfig["height"].toInt(96);
+			if (grabberConfig["autoResolution"].toBool(false))
+			{
+				const QSize size = ledImageSize();
+				_grabber_width  = size.width();
+				_grabber_height = size.height();
+				Info(_log, "capture size %dx%d derived from the led layout", size.width(), size.height());
+			}
 			_grabber_frequency = grabberConfig["frequency_Hz"].toInt(10);
 			_grabber_priority  = grabberConfig["priority"].toInt(900);
 
@@ -481,6 +503,7 @@ void HyperionDaemon::createGrabberDispmanx()
 	QObject::connect(_kodiVideoChecker, SIGNAL(videoMode(VideoMode)), _dispmanx, SLOT(setVideoMode(VideoMode)));
 	QObject::connect(_dispmanx, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)) );
 	QObject::connect(_dispmanx, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)) );
+	_instances->addGrabber(_dispmanx, hyperion::COMP_GRABBER);
 
 	_dispmanx->start();
 
@@ -500,6 +523,7 @@ void HyperionDaemon::createGrabberAmlogic()
 	QObject::connect(_kodiVideoChecker, SIGNAL(videoMode(VideoMode)),       _amlGrabber, SLOT(setVideoMode(VideoMode)));
 	QObject::connect(_amlGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)) );
 	QObject::connect(_amlGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)) );
+	_instances->addGrabber(_amlGrabber, hyperion::COMP_GRABBER);
 
 	_amlGrabber->start();
 	Info(_log, "AMLOGIC grabber created and started");
@@ -517,11 +541,17 @@ void HyperionDaemon::createGrabberX11(const QJsonObject & grabberConfig)
 				grabberConfig["horizontalPixelDecimation"].toInt(8),
 				grabberConfig["verticalPixelDecimation"].toInt(8),
 				_grabber_frequency, _grabber_priority );
+	if (grabberConfig["autoResolution"].toBool(false))
+	{
+		_x11Grabber->setTargetSize(_grabber_width, _grabber_height);
+	}
+	_x11Grabber->setDamageTracking(grabberConfig["useXDamage"].toBool(false), grabberConfig["useXDamageRegions"].toBool(false));
 
 	QObject::connect(_kodiVideoChecker, SIGNAL(grabbingMode(GrabbingMode)), _x11Grabber, SLOT(setGrabbingMode(GrabbingMode)));
 	QObject::connect(_kodiVideoChecker, SIGNAL(videoMode(VideoMode)),       _x11Grabber, SLOT(setVideoMode(VideoMode)));
 	QObject::connect(_x11Grabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)) );
 	QObject::connect(_x11Grabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)) );
+	_instances->addGrabber(_x11Grabber, hyperion::COMP_GRABBER);
 
 	_x11Grabber->start();
 	Info(_log, "X11 grabber created and started");
@@ -538,11 +568,14 @@ void HyperionDaemon::createGrabberFramebuffer(const QJsonObject & grabberConfig)
 	_fbGrabber = new FramebufferWrapper(
 				grabberConfig["device"].toString("/dev/fb0").toStdString(),
 				_grabber_width, _grabber_height, _grabber_frequency, _grabber_priority);
+	_fbGrabber->setWaitForVsync(grabberConfig["waitForVsync"].toBool(false));
+	_fbGrabber->setPixelAveraging(grabberConfig["pixelAveraging"].toBool(false));
 	
 	QObject::connect(_kodiVideoChecker, SIGNAL(grabbingMode(GrabbingMode)), _fbGrabber, SLOT(setGrabbingMode(GrabbingMode)));
 	QObject::connect(_kodiVideoChecker, SIGNAL(videoMode(VideoMode)), _fbGrabber, SLOT(setVideoMode(VideoMode)));
 	QObject::connect(_fbGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)) );
 	QObject::connect(_fbGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)) );
+	_instances->addGrabber(_fbGrabber, hyperion::COMP_GRABBER);
 
 	_fbGrabber->start();
 	Info(_log, "Framebuffer grabber created and started");
@@ -564,6 +597,7 @@ void HyperionDaemon::createGrabberOsx(const QJsonObject & grabberConfig)
 	QObject::connect(_kodiVideoChecker, SIGNAL(videoMode(VideoMode)), _osxGrabber, SLOT(setVideoMode(VideoMode)));
 	QObject::connect(_osxGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)) );
 	QObject::connect(_osxGrabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)) );
+	_instances->addGrabber(_osxGrabber, hyperion::COMP_GRABBER);
 
 	_osxGrabber->start();
 	Info(_log, "OSX grabber created and started");
@@ -573,6 +607,11 @@ void HyperionDaemon::createGrabberOsx(const QJsonObject & grabberConfig)
 }
 
 
+QSize HyperionDaemon::ledImageSize() const
+{
+	return _hyperion->getLedImageSize().expandedTo(_instances->getLedImageSize());
+}
+
 void HyperionDaemon::createGrabberV4L2()
 {
 	// construct and start the v4l2 grabber if the configuration is present
@@ -606,6 +645,12 @@ void HyperionDaemon::createGrabberV4L2()
 				grabberConfig["blueSignalThreshold"].toDouble(0.0),
 				grabberConfig["priority"].toInt(890));
 			grabber->set3D(parse3DMode(grabberConfig["mode"].toString("2D").toStdString()));
+			grabber->setPixelAveraging(grabberConfig["pixelAveraging"].toBool(false));
+			if (grabberConfig["autoResolution"].toBool(false))
+			{
+				const QSize size = ledImageSize();
+				grabber->setTargetSize(size.width(), size.height());
+			}
 			grabber->setCropping(
 				grabberConfig["cropLeft"].toInt(0),
 				grabberConfig["cropRight"].toInt(0),
@@ -620,6 +665,7 @@ void HyperionDaemon::createGrabberV4L2()
 
 			QObject::connect(grabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _protoServer, SLOT(sendImageToProtoSlaves(int, const Image<ColorRgb>&, const int)));
 			QObject::connect(grabber, SIGNAL(emitImage(int, const Image<ColorRgb>&, const int)), _hyperion, SLOT(setImage(int, const Image<ColorRgb>&, const int)));
+			_instances->addGrabber(grabber, hyperion::COMP_V4L);
 			if (grabberConfig["useKodiChecker"].toBool(false))
 			{
 				QObject::connect(_kodiVideoChecker, SIGNAL(grabbingMode(GrabbingMode)), grabber, SLOT(setGrabbingMode(GrabbingMode)));
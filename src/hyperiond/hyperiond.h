@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QSize>
 
 #ifdef ENABLE_DISPMANX
 	#include <grabber/DispmanxWrapper.h>
@@ -45,6 +46,7 @@
 #include <protoserver/ProtoServer.h>
 #include <boblightserver/BoblightServer.h>
 #include <udplistener/UDPListener.h>
+#include <hyperion/HyperionInstances.h>
 #include <QJsonObject>
 
 class HyperionDaemon : public QObject
@@ -76,6 +78,9 @@ private:
 	void createGrabberOsx(const QJsonObject & grabberConfig);
 	void createGrabberX11(const QJsonObject & grabberConfig);
 
+	/// @return the smallest capture size at which the led areas of all instances cover enough pixels
+	QSize ledImageSize() const;
+
 	Logger*             _log;
 	QJsonObject         _qconfig;
 	KODIVideoChecker*   _kodiVideoChecker;
@@ -92,6 +97,7 @@ private:
 	FramebufferWrapper* _fbGrabber; 
 	OsxWrapper*         _osxGrabber;
 	Hyperion*           _hyperion;
+	HyperionInstances*  _instances;
 	
 	unsigned            _grabber_width;
 	unsigned            _grabber_height;
@@ -0,0 +1,83 @@
+
+// STL includes
+#include <iostream>
+#include <vector>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+#include <utils/ImageStatistics.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+
+using namespace hyperion;
+
+///
+/// Checks the mean colors of the image to led mapping on an image whose channel sums exceed
+/// 32 bit, and the center region check of the no signal detection
+///
+int main()
+{
+	int errors = 0;
+
+	// 20M pixels, the sum of a bright channel needs more than 32 bit
+	const unsigned width  = 5000;
+	const unsigned height = 4000;
+	Image<ColorRgb> image(width, height, ColorRgb{255, 254, 200});
+
+	// the bottom half is darker, the mean is between both halves
+	ColorRgb * pixels = image.memptr();
+	for (size_t idx = size_t(width) * height / 2; idx < size_t(width) * height; ++idx)
+	{
+		pixels[idx] = ColorRgb{205, 104, 0};
+	}
+
+	Led led;
+	led.index      = 0;
+	led.minX_frac  = 0.0;
+	led.maxX_frac  = 0.01;
+	led.minY_frac  = 0.0;
+	led.maxY_frac  = 0.01;
+	led.clone      = -1;
+	led.colorOrder = ORDER_RGB;
+	const ImageToLedsMap map(width, height, 0, 0, std::vector<Led>(1, led));
+
+	std::vector<ColorRgb> ledColors(1);
+	map.getUniLedColor(image, ledColors);
+	if (ledColors[0] != ColorRgb{230, 179, 100})
+	{
+		std::cout << "Uni color mean error " << ledColors[0] << std::endl;
+		++errors;
+	}
+
+	map.getMeanLedColor(image, ledColors);
+	if (ledColors[0] != ColorRgb{255, 254, 200})
+	{
+		std::cout << "Led mean error " << ledColors[0] << std::endl;
+		++errors;
+	}
+
+	// a bright pixel counts only inside the center region
+	Image<ColorRgb> noSignal(64, 64, ColorRgb::BLACK);
+	ImageStatistics statistics;
+	statistics.setCenterRegion(0.25, 0.25, 0.75, 0.75);
+	const ColorRgb threshold = {16, 16, 16};
+
+	noSignal.memptr()[0] = ColorRgb{255, 255, 255};
+	if (statistics.centerExceeds(noSignal, threshold))
+	{
+		std::cout << "Pixel outside of the center region detected" << std::endl;
+		++errors;
+	}
+
+	noSignal.memptr()[32 * 64 + 32] = ColorRgb{0, 0, 17};
+	if (!statistics.centerExceeds(noSignal, threshold))
+	{
+		std::cout << "Pixel inside of the center region not detected" << std::endl;
+		++errors;
+	}
+
+	std::cout << (errors == 0 ? "Passed" : "Failed") << std::endl;
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// STL includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+// libjpeg includes
+#include <jpeglib.h>
+
+// Local includes
+#include "grabber/v4l2/MjpegDecoder.h"
+
+namespace
+{
+	///
+	/// Encodes a color gradient of the given size as a JPEG frame
+	///
+	std::vector<uint8_t> encodeFrame(const int width, const int height)
+	{
+		struct jpeg_compress_struct cinfo;
+		struct jpeg_error_mgr errorManager;
+		cinfo.err = jpeg_std_error(&errorManager);
+		jpeg_create_compress(&cinfo);
+
+		unsigned char * buffer = nullptr;
+		unsigned long bufferSize = 0;
+		jpeg_mem_dest(&cinfo, &buffer, &bufferSize);
+
+		cinfo.image_width      = width;
+		cinfo.image_height     = height;
+		cinfo.input_components = 3;
+		cinfo.in_color_space   = JCS_RGB;
+		jpeg_set_defaults(&cinfo);
+		jpeg_start_compress(&cinfo, TRUE);
+
+		std::vector<uint8_t> row(width * 3);
+		while (cinfo.next_scanline < cinfo.image_height)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				row[x*3]   = uint8_t(x * 255 / width);
+				row[x*3+1] = uint8_t(cinfo.next_scanline * 255 / height);
+				row[x*3+2] = 128;
+			}
+			JSAMPROW rowPointer = row.data();
+			jpeg_write_scanlines(&cinfo, &rowPointer, 1);
+		}
+		jpeg_finish_compress(&cinfo);
+		jpeg_destroy_compress(&cinfo);
+
+		const std::vector<uint8_t> frame(buffer, buffer + bufferSize);
+		free(buffer);
+		return frame;
+	}
+
+	///
+	/// Feeds the frames of a recorded MJPEG stream to the decoder, the way the device would deliver
+	/// them, and reports the decoding time per downscaling
+	///
+	int benchmark(const char * fileName)
+	{
+		std::ifstream file(fileName, std::ios::binary);
+		const std::vector<uint8_t> stream((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		// split the stream at the start of image markers
+		std::vector<size_t> frameStarts;
+		for (size_t i = 0; i + 2 < stream.size(); ++i)
+		{
+			if (stream[i] == 0xFF && stream[i+1] == 0xD8 && stream[i+2] == 0xFF)
+			{
+				frameStarts.push_back(i);
+			}
+		}
+		frameStarts.push_back(stream.size());
+		std::cout << "Frames: " << frameStarts.size() - 1 << std::endl;
+
+		int errors = 0;
+		MjpegDecoder decoder;
+		for (unsigned scale = 1; scale <= 8; scale *= 2)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t frame = 0; frame + 1 < frameStarts.size(); ++frame)
+			{
+				if (!decoder.decode(stream.data() + frameStarts[frame], frameStarts[frame+1] - frameStarts[frame], scale))
+				{
+					std::cout << "Frame " << frame << " could not be decoded: " << decoder.error() << std::endl;
+					++errors;
+				}
+			}
+			const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+			std::cout << "Scale 1/" << scale << ": " << decoder.width() << "x" << decoder.height() << ", "
+				<< duration.count() / std::max<size_t>(1, frameStarts.size() - 1) << " us per frame" << std::endl;
+		}
+		return errors;
+	}
+}
+
+///
+/// Decodes generated frames at every downscaling of the decoder of the V4L2 grabber and checks
+/// the decoded sizes and the failure of a truncated frame. A recorded MJPEG stream (e.g.
+/// 'ffmpeg -f v4l2 -input_format mjpeg -i /dev/video0 -c copy -f mjpeg capture.mjpeg') can be
+/// passed to additionally measure the decoding time.
+///
+int main(int argc, char** argv)
+{
+	if (!MjpegDecoder::available())
+	{
+		std::cout << "Built without MJPEG support" << std::endl;
+		return 0;
+	}
+
+	int errors = 0;
+	MjpegDecoder decoder;
+
+	// sizes which are no multiple of the downscaling are rounded up
+	const int width  = 100;
+	const int height = 60;
+	const std::vector<uint8_t> frame = encodeFrame(width, height);
+	for (unsigned scale = 1; scale <= 8; scale *= 2)
+	{
+		const int expectedWidth  = (width  + scale - 1) / scale;
+		const int expectedHeight = (height + scale - 1) / scale;
+		if (!decoder.decode(frame.data(), frame.size(), scale))
+		{
+			std::cout << "Scale 1/" << scale << ": frame could not be decoded: " << decoder.error() << std::endl;
+			++errors;
+		}
+		else if (decoder.width() != expectedWidth || decoder.height() != expectedHeight)
+		{
+			std::cout << "Scale 1/" << scale << ": decoded " << decoder.width() << "x" << decoder.height()
+				<< " instead of " << expectedWidth << "x" << expectedHeight << std::endl;
+			++errors;
+		}
+	}
+
+	// a truncated frame must fail without terminating the grabber, the next frame must decode again
+	if (decoder.decode(frame.data(), 16, 1))
+	{
+		std::cout << "Truncated frame was decoded" << std::endl;
+		++errors;
+	}
+	if (!decoder.decode(frame.data(), frame.size(), 2))
+	{
+		std::cout << "Frame after a truncated frame could not be decoded: " << decoder.error() << std::endl;
+		++errors;
+	}
+
+	if (argc > 1)
+	{
+		errors += benchmark(argv[1]);
+	}
+
+	std::cout << (errors == 0 ? "Passed" : "Failed") << std::endl;
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+
+// STL includes
+#include <iostream>
+#include <map>
+#include <vector>
+
+// QT includes
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "../libsrc/leddevice/LedDevicePhilipsHue.h"
+
+namespace
+{
+	///
+	/// Minimal HTTP server standing in for a Hue bridge. It answers the light state queries and
+	/// counts the color changes per light. The replies to state changes can be held back to
+	/// simulate a busy bridge.
+	///
+	class FakeBridge
+	{
+	public:
+		FakeBridge()
+			: _holdReplies(false)
+		{
+			_server.listen(QHostAddress::LocalHost);
+			QObject::connect(&_server, &QTcpServer::newConnection, [this]()
+			{
+				while (_server.hasPendingConnections())
+				{
+					QTcpSocket * socket = _server.nextPendingConnection();
+					QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { readRequests(socket); });
+				}
+			});
+		}
+
+		quint16 port() const
+		{
+			return _server.serverPort();
+		}
+
+		/// Holds back the replies to state changes, or sends the held replies and answers directly again
+		void holdReplies(const bool hold)
+		{
+			_holdReplies = hold;
+			if (!hold)
+			{
+				for (QTcpSocket * socket : _heldReplies)
+				{
+					reply(socket, "[{\"success\":{}}]");
+				}
+				_heldReplies.clear();
+			}
+		}
+
+		/// The number of color changes per light id
+		std::map<int, int> colorChanges;
+
+		int colorChangeCount() const
+		{
+			int count = 0;
+			for (const auto & changes : colorChanges)
+			{
+				count += changes.second;
+			}
+			return count;
+		}
+
+	private:
+		void readRequests(QTcpSocket * socket)
+		{
+			QByteArray & buffer = _buffers[socket];
+			buffer += socket->readAll();
+
+			// the requests of a connection may arrive in pieces or several at once
+			for (;;)
+			{
+				const int headerEnd = buffer.indexOf("\r\n\r\n");
+				if (headerEnd < 0)
+				{
+					return;
+				}
+				const QByteArray header = buffer.left(headerEnd);
+				int contentLength = 0;
+				for (const QByteArray & line : header.split('\n'))
+				{
+					if (line.toLower().startsWith("content-length:"))
+					{
+						contentLength = line.mid(15).trimmed().toInt();
+					}
+				}
+				if (buffer.size() < headerEnd + 4 + contentLength)
+				{
+					return;
+				}
+
+				const QList<QByteArray> requestLine = header.left(header.indexOf('\r')).split(' ');
+				const QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+				buffer.remove(0, headerEnd + 4 + contentLength);
+				handleRequest(socket, requestLine.value(0), requestLine.value(1), body);
+			}
+		}
+
+		void handleRequest(QTcpSocket * socket, const QByteArray & method, const QByteArray & path, const QByteArray & body)
+		{
+			// "/api/<user>/lights/<id>[/state]"
+			const QList<QByteArray> parts = path.split('/');
+			if (method == "GET")
+			{
+				reply(socket, "{\"state\": {\"on\": true, \"xy\": [0.4, 0.4], \"bri\": 128}, \"modelid\": \"LCT001\"}");
+				return;
+			}
+
+			if (body.contains("xy"))
+			{
+				++colorChanges[parts.value(4).toInt()];
+			}
+			if (_holdReplies)
+			{
+				_heldReplies << socket;
+			}
+			else
+			{
+				reply(socket, "[{\"success\":{}}]");
+			}
+		}
+
+		void reply(QTcpSocket * socket, const QByteArray & body)
+		{
+			socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: "
+				+ QByteArray::number(body.size()) + "\r\n\r\n" + body);
+		}
+
+		QTcpServer _server;
+		QHash<QTcpSocket *, QByteArray> _buffers;
+		bool _holdReplies;
+		QList<QTcpSocket *> _heldReplies;
+	};
+
+	/// Runs the event loop for the given time
+	void wait(const int ms)
+	{
+		QEventLoop loop;
+		QTimer::singleShot(ms, &loop, SLOT(quit()));
+		loop.exec();
+	}
+}
+
+///
+/// Drives the Philips Hue device against a local fake bridge and checks the request pacing:
+/// every light gets its share of the request budget, unchanged colors are not sent and changes
+/// written while the bridge is busy are sent once it catches up.
+///
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	FakeBridge bridge;
+	const int lightCount  = 12;
+	const int requestRate = 50;
+
+	QJsonObject deviceConfig;
+	deviceConfig["output"]      = QString("127.0.0.1:%1").arg(bridge.port());
+	deviceConfig["username"]    = QString("newdeveloper");
+	deviceConfig["requestRate"] = requestRate;
+	QJsonArray lightIds;
+	for (int id = 1; id <= lightCount; ++id)
+	{
+		lightIds.append(id);
+	}
+	deviceConfig["lightIds"] = lightIds;
+
+	LedDevice::setLedCount(lightCount);
+	LedDevicePhilipsHue device(deviceConfig);
+	int errors = 0;
+
+	// all lights change on every frame for one second, the budget is shared round-robin
+	std::vector<ColorRgb> colors(lightCount, ColorRgb::BLACK);
+	for (int frame = 0; frame < 25; ++frame)
+	{
+		colors.assign(lightCount, ColorRgb{uint8_t(frame * 10), 0, uint8_t(255 - frame * 10)});
+		device.setLedValues(colors);
+		wait(40);
+	}
+	for (int id = 1; id <= lightCount; ++id)
+	{
+		if (bridge.colorChanges[id] < 2)
+		{
+			std::cout << "Light " << id << " got " << bridge.colorChanges[id] << " changes" << std::endl;
+			++errors;
+		}
+	}
+	if (bridge.colorChangeCount() > requestRate * 12 / 10 + 2)
+	{
+		std::cout << "Request budget exceeded: " << bridge.colorChangeCount() << " requests" << std::endl;
+		++errors;
+	}
+
+	// let the pending changes drain, the same colors again are not sent
+	wait(500);
+	const int changesBefore = bridge.colorChangeCount();
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		device.setLedValues(colors);
+		wait(40);
+	}
+	if (bridge.colorChangeCount() != changesBefore)
+	{
+		std::cout << "Unchanged colors were sent " << bridge.colorChangeCount() - changesBefore << " times" << std::endl;
+		++errors;
+	}
+
+	// two unanswered changes keep the bridge busy, nothing else is left to send
+	bridge.holdReplies(true);
+	colors[0] = ColorRgb::GREEN;
+	colors[1] = ColorRgb::WHITE;
+	device.setLedValues(colors);
+	wait(200);
+
+	// a change written while the bridge is busy is sent once it answers, without another write
+	const int light3Changes = bridge.colorChanges[3];
+	colors[2] = ColorRgb::BLUE;
+	device.setLedValues(colors);
+	wait(100);
+	bridge.holdReplies(false);
+	wait(300);
+	if (bridge.colorChanges[3] != light3Changes + 1)
+	{
+		std::cout << "Change during a busy bridge was not sent" << std::endl;
+		++errors;
+	}
+
+	std::cout << (errors == 0 ? "Passed" : "Failed") << std::endl;
+	return errors == 0 ? 0 : 1;
+}
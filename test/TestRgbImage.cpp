@@ -1,6 +1,7 @@
 
 // STL includes
 #include <iostream>
+#include <utility>
 
 // Utils includes
 #include <utils/Image.h>
@@ -36,9 +37,31 @@ int main()
 			std::cout << "RGB error idx " << i << " " << rgb << std::endl;
 	}
 
-	
-	
-	
+	std::cout << "Sharing image" << std::endl;
+	Image<ColorRgb> image_copy(image_rgb);
+	const Image<ColorRgb> & const_rgb = image_rgb;
+	const Image<ColorRgb> & const_copy = image_copy;
+	if (const_rgb.memptr() != const_copy.memptr())
+		std::cout << "copy does not share the pixels" << std::endl;
+
+	// writing the copy must not change the original
+	image_copy(0, 0) = ColorRgb::BLACK;
+	if (const_rgb(0, 0).red != 255 || const_copy(0, 0).red != 0)
+		std::cout << "copy on write error" << std::endl;
+
+	Image<ColorRgb> image_moved(std::move(image_copy));
+	if (image_moved(0, 0).red != 0 || image_copy.width() != 1)
+		std::cout << "move error" << std::endl;
+
+	// view of the right half, without copying
+	const ImageView<ColorRgb> half = image_rgb.view(width/2, 0, width/2, height);
+	const Image<ColorRgb> image_half(half);
+	if (half.stride() != unsigned(width) || image_half.width() != unsigned(width/2) || image_half(0, 0).red != 255)
+		std::cout << "view error" << std::endl;
+
+	if (reinterpret_cast<uintptr_t>(const_rgb.memptr()) % Image<ColorRgb>::ALIGNMENT != 0)
+		std::cout << "alignment error" << std::endl;
+
 
 	std::cout << "Finished (destruction will be performed)" << std::endl;
 
@@ -0,0 +1,82 @@
+
+// STL includes
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+// Qt includes
+#include <QJsonObject>
+#include <QJsonArray>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+
+#include "../libsrc/leddevice/LedDeviceWs2812SPI.h"
+
+std::vector<uint8_t> readFile(const std::string & fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+int main()
+{
+	// two outputs backed by files: 4 leds on the first, the remaining 6 on the second
+	const std::string fileNames[2] = { "/tmp/hyperion_test_spi0", "/tmp/hyperion_test_spi1" };
+	remove(fileNames[0].c_str());
+	remove(fileNames[1].c_str());
+
+	QJsonObject firstOutput;
+	firstOutput["output"] = QString::fromStdString(fileNames[0]);
+	firstOutput["leds"]   = 4;
+	QJsonObject secondOutput;
+	secondOutput["output"] = QString::fromStdString(fileNames[1]);
+
+	QJsonObject deviceConfig;
+	deviceConfig["outputs"] = QJsonArray() << firstOutput << secondOutput;
+
+	LedDevice::setLedCount(10);
+	LedDeviceWs2812SPI ledDevice(deviceConfig);
+	if (ledDevice.open() != 0)
+	{
+		std::cerr << "Failed to open the SPI outputs" << std::endl;
+		return 1;
+	}
+
+	std::vector<ColorRgb> ledValues(10, ColorRgb::BLACK);
+	ledValues[0] = ColorRgb::RED;
+	ledValues[4] = ColorRgb::BLUE;
+	if (ledDevice.setLedValues(ledValues) < 0)
+	{
+		std::cerr << "Failed to write the SPI outputs" << std::endl;
+		return 1;
+	}
+
+	// 12 SPI bytes per led and 3 latch bytes per output
+	const std::vector<uint8_t> first  = readFile(fileNames[0]);
+	const std::vector<uint8_t> second = readFile(fileNames[1]);
+	if (first.size() != 4*12+3 || second.size() != 6*12+3)
+	{
+		std::cerr << "Unexpected output sizes " << first.size() << " and " << second.size() << std::endl;
+		return 1;
+	}
+
+	// a 0xff colour byte encodes to 0xcc (1100 1100), a 0x00 colour byte to 0x88 (1000 1000)
+	const uint8_t redLed[12]  = { 0xcc,0xcc,0xcc,0xcc, 0x88,0x88,0x88,0x88, 0x88,0x88,0x88,0x88 };
+	const uint8_t blueLed[12] = { 0x88,0x88,0x88,0x88, 0x88,0x88,0x88,0x88, 0xcc,0xcc,0xcc,0xcc };
+	if (!std::equal(redLed, redLed + 12, first.begin()) || !std::equal(blueLed, blueLed + 12, second.begin()))
+	{
+		std::cerr << "The leds are not split across the outputs" << std::endl;
+		return 1;
+	}
+
+	remove(fileNames[0].c_str());
+	remove(fileNames[1].c_str());
+
+	std::cout << "SPI outputs written correctly" << std::endl;
+	return 0;
+}